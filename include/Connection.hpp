@@ -0,0 +1,104 @@
+#ifndef CONNECTION_HPP
+# define CONNECTION_HPP
+
+# include "utils/Common.hpp"
+# include "socket/OutboundQueue.hpp"
+# include "http/parser/RequestParser.hpp"
+# include "http/parser/ChunkedDecoder.hpp"
+
+# define MAX_READS_PER_EVENT 16 // Nombre max de recv() par réveil, pour ne pas affamer les autres clients
+# define MAX_IDLE_BUFFER_SIZE (64 * 1024) // Au-delà, le tampon d'un slot libéré est rendu au système
+
+class Server;
+
+/**
+ * @brief État d'une connexion client entre deux réveils de la boucle d'événements
+ *
+ * La lecture d'une requête est incrémentale : chaque réveil ajoute les octets
+ * disponibles au tampon puis fait avancer la machine à états. Sur EAGAIN on
+ * rend la main à la boucle, la lecture reprend au prochain POLLIN. Les
+ * réponses passent par une file de sortie vidée au rythme des POLLOUT.
+ */
+struct Connection {
+    enum ReadState {
+        READ_HEADERS,   // En attente de la fin des en-têtes (\r\n\r\n)
+        READ_BODY,      // En-têtes reçus, en attente du body (Content-Length ou chunked)
+        READ_COMPLETE,  // Requête complète, prête à être traitée
+        READ_ERROR      // Requête invalide (code d'erreur dans parser)
+    };
+
+    enum TimerPhase {
+        TIMER_NONE,
+        TIMER_HEADER,     // client_header_timeout : réception des en-têtes
+        TIMER_BODY,       // client_body_timeout : entre deux lectures du body
+        TIMER_KEEPALIVE,  // keepalive_timeout : attente de la requête suivante
+        TIMER_SEND,       // send_timeout : entre deux écritures de la réponse
+        TIMER_LINGER      // LINGERING_TIMEOUT : fin de l'envoi d'une requête refusée
+    };
+
+    int fd;                     // -1 si le slot est libre
+    Server* server;             // Serveur propriétaire de la connexion
+    ReadState read_state;
+    std::string read_buffer;    // Octets reçus pour la requête en cours
+    RequestParser parser;       // Parsing incrémental de read_buffer, sans copie
+    ChunkedDecoder decoder;     // Décodage du body chunked au fil de la réception
+    std::string body;           // Body chunked décodé (les octets encodés sont retirés de read_buffer)
+    size_t max_body_size;       // client_max_body_size de la location, connu à la fin des en-têtes
+    bool expect_continue;       // "Expect: 100-continue" en attente de réponse
+
+    OutboundQueue outbound;     // Réponses en attente d'envoi
+    bool close_after_write;     // Fermer la connexion une fois la file de sortie vidée
+    bool lingering_close;       // Lire et jeter le reste de la requête refusée avant de fermer
+
+    TimerPhase timer_phase;     // Timeout actuellement armé dans la roue de timers
+    size_t requests_served;     // Nombre de requêtes traitées sur cette connexion
+
+    Connection();
+
+    /**
+     * @brief Attribue le slot à un client nouvellement accepté
+     */
+    void open(int fd, Server* server);
+
+    /**
+     * @brief Libère le slot en conservant ses tampons pour la connexion suivante
+     */
+    void release();
+
+    bool isOpen() const { return fd >= 0; }
+
+    /**
+     * @brief Fait avancer la machine à états avec les octets déjà reçus
+     * @return true si la requête est complète
+     */
+    bool advance();
+
+    /**
+     * @brief Retire la requête traitée du tampon et analyse la suivante (pipelining)
+     */
+    void consumeRequest();
+
+    /**
+     * @brief Abandonne tout le contenu du tampon de lecture
+     */
+    void resetRequest();
+
+    /**
+     * @brief Refuse la requête en cours avant la fin de sa réception
+     */
+    void rejectRequest(int code);
+
+    /**
+     * @brief Le body de la requête en cours a-t-il commencé à arriver ?
+     */
+    bool bodyStarted() const;
+
+    bool isComplete() const { return read_state == READ_COMPLETE; }
+    bool hasError() const { return read_state == READ_ERROR; }
+
+private:
+    void startBody();
+    void decodeChunkedBody();
+};
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef CONNECTION_TABLE_HPP
+# define CONNECTION_TABLE_HPP
+
+# include "Connection.hpp"
+# include <vector>
+
+# define INITIAL_SLOTS 1024         // Taille initiale de la table
+# define DEFAULT_MAX_SLOTS 65536    // Limite retenue si RLIMIT_NOFILE est illimité
+
+/**
+ * @brief Table des connexions clients indexée par fd
+ *
+ * Un tableau contigu de slots remplace les std::map : retrouver l'état d'un
+ * client coûte un accès indexé, et accept/close ne font plus d'allocation de
+ * nœud. La table grandit à la demande jusqu'à la limite RLIMIT_NOFILE du
+ * processus ; les slots libérés gardent leurs tampons pour le fd suivant.
+ */
+class ConnectionTable {
+public:
+    ConnectionTable();
+
+    /**
+     * @brief Attribue le slot d'un fd nouvellement accepté
+     * @return Le slot, ou NULL si le fd dépasse la limite de descripteurs
+     */
+    Connection* open(int fd, Server* server);
+
+    /**
+     * @brief Slot d'un fd client ouvert
+     * @return Le slot, ou NULL si aucun client n'est associé à ce fd
+     */
+    Connection* get(int fd) {
+        if (fd < 0 || static_cast<size_t>(fd) >= slots.size() || !slots[fd].isOpen()) {
+            return NULL;
+        }
+        return &slots[fd];
+    }
+
+    void release(int fd);
+
+    size_t size() const { return active; }     // Nombre de connexions ouvertes
+    size_t limit() const { return max_slots; } // Nombre maximal de slots (RLIMIT_NOFILE)
+    int maxFd() const { return static_cast<int>(slots.size()) - 1; }
+
+private:
+    std::vector<Connection> slots;  // Slots indexés par fd
+    size_t max_slots;               // Limite de descripteurs du processus
+    size_t active;                  // Slots occupés
+
+    ConnectionTable(const ConnectionTable&);
+    ConnectionTable& operator=(const ConnectionTable&);
+};
+
+#endif
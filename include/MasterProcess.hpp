@@ -0,0 +1,46 @@
+#ifndef MASTER_PROCESS_HPP
+# define MASTER_PROCESS_HPP
+
+# include "utils/Common.hpp"
+# include "config/ConfigTypes.hpp"
+# include <vector>
+# include <sys/types.h>
+
+# define WORKER_RESPAWN_DELAY 1 // Délai (s) avant de relancer un worker mort juste après son démarrage
+
+/**
+ * @brief Processus maître du mode multi-workers (directive worker_processes)
+ *
+ * Le maître fork N workers. Chaque worker ouvre ses propres sockets d'écoute
+ * avec SO_REUSEPORT et exécute sa propre boucle d'événements via
+ * MultiServerManager. Le maître ne traite aucune requête : il surveille les
+ * workers, relance ceux qui meurent et propage les signaux d'arrêt et de
+ * rechargement (SIGHUP).
+ */
+class MasterProcess
+{
+  private:
+    const WebservConfig& config;
+    std::vector<pid_t> workers;                  // PIDs des workers (un slot par worker)
+    std::vector<time_t> spawn_times;             // Date de lancement de chaque worker
+    
+    static volatile sig_atomic_t stop_requested; // Positionné par SIGINT/SIGTERM
+    static volatile sig_atomic_t reload_requested; // Positionné par SIGHUP
+    static void signalHandler(int signal);
+    
+    void setupSignalHandlers();
+    pid_t spawnWorker(size_t slot);              // Fork un worker pour le slot donné
+    int runWorker(size_t slot);                  // Corps d'un worker (ne retourne que dans le fils)
+    void stopWorkers();                          // Envoie SIGTERM et attend tous les workers
+    void signalWorkers(int signal);              // Transmet un signal à tous les workers vivants
+    int findSlot(pid_t pid) const;
+    
+  public:
+    MasterProcess(const WebservConfig& config);
+    ~MasterProcess();
+    
+    static int resolveWorkerCount(int configured); // 0 (auto) -> nombre de cœurs
+    int run();                                     // Boucle de supervision, retourne le code de sortie
+};
+
+#endif
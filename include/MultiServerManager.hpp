@@ -4,37 +4,52 @@
 # include "utils/Common.hpp"
 # include "Server.hpp"
 # include "config/ConfigTypes.hpp"
+# include "event/Poller.hpp"
+# include "event/TimerWheel.hpp"
+# include "ConnectionTable.hpp"
 # include <vector>
 # include <map>
 
-# define MAX_POLL_SIZE 10240 // Maximum nombre de descripteurs pour poll
+# define MAX_POLL_SIZE 10240 // Maximum nombre de descripteurs surveillés
 
 /**
  * @brief Gestionnaire centralisé de plusieurs serveurs HTTP
  * 
  * Cette classe gère plusieurs serveurs HTTP simultanément en utilisant
- * un seul appel poll() centralisé pour toutes les opérations d'entrée/sortie.
+ * une seule boucle d'événements (epoll ou poll) pour toutes les opérations d'entrée/sortie.
  */
 class MultiServerManager
 {
   private:
     std::vector<Server*> servers;                // Liste des serveurs gérés
     std::map<int, int> port_to_server_index;     // Mapping port -> index de serveur
-    std::map<int, Server*> fd_to_server;         // Mapping fd -> serveur
     
-    struct pollfd* poll_fds;                     // Tableau des descripteurs pour poll
-    int nfds;                                    // Nombre de descripteurs actifs
+    Poller* poller;                              // Backend de multiplexage (epoll/poll)
+    std::string event_backend;                   // Backend demandé dans la configuration
+    bool reuse_port;                             // SO_REUSEPORT sur les sockets d'écoute (mode multi-workers)
+    int reserve_fd;                              // fd de réserve libéré pour refuser une connexion sur EMFILE
+    std::vector<PollEvent> ready_events;         // Événements prêts du dernier réveil
+    ConnectionTable connections;                 // État des connexions clients indexé par fd
+    TimerWheel timers;                           // Timeouts des connexions clients
+    std::vector<int> expired_fds;                // Clients dont le timer a expiré au dernier tick
     bool running;                                // État d'exécution des serveurs
+    volatile sig_atomic_t reload_requested;      // SIGHUP reçu : pages d'erreur à relire (écrit par le handler)
     
     static MultiServerManager* instance;         // Instance singleton pour le gestionnaire de signaux
     static void signalHandler(int signal);       // Gestionnaire de signal unifié
     
     // Méthodes privées
     void setupSignalHandlers();                  // Configuration des gestionnaires de signal
-    Server* getServerByFd(int fd) const;         // Obtenir le serveur associé à un fd
-    void addFdToPoll(int fd, Server* server);    // Ajouter un fd au tableau poll
-    void removeFdFromPoll(int fd_index);         // Supprimer un fd du tableau poll
-    bool handleEvent(int index);                 // Gère un événement poll, retourne false si le fd a été supprimé
+    bool addFdToPoll(int fd, Server* server);    // Ajouter un fd à la boucle d'événements
+    void removeFdFromPoll(int fd);               // Retirer un fd de la boucle d'événements
+    void handleEvent(const PollEvent& event);    // Gère un événement prêt
+    void handleTimeouts();                       // Traite les timers expirés
+    void reloadErrorPages();                     // Relit les pages d'erreur de chaque serveur
+    void acceptConnections(Server* server);      // Accepte les connexions en attente, budget adaptatif
+    void rejectWithReserveFd(Server* server);    // Refuse une connexion malgré EMFILE/ENFILE
+    void handleClientEvent(Connection& conn, int events); // Gère un événement sur un socket client
+    void updateClient(Connection& conn);         // Met à jour les événements surveillés et le timer d'un client
+    void closeClient(Connection& conn);          // Retire un client de la boucle et ferme sa connexion
     
   public:
     MultiServerManager();
@@ -43,8 +58,8 @@ class MultiServerManager
     // Initialisation et démarrage des serveurs
     void initServers(const WebservConfig& config); // Initialiser les serveurs depuis la configuration
     void initializeServers();                      // Nouvelle méthode d'initialisation des serveurs
-    void startServers();                           // Démarrer tous les serveurs avec un poll centralisé
+    void startServers();                           // Démarrer tous les serveurs avec une boucle d'événements centralisée
     void stopServers();                            // Arrêter tous les serveurs
 };
 
-#endif 
\ No newline at end of file
+#endif
\ No newline at end of file
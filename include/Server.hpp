@@ -8,8 +8,13 @@
 # include "http/ResponseHandler.hpp"
 # include "http/RouteHandler.hpp"
 # include "config/ConfigTypes.hpp"
+# include "Connection.hpp"
+# include "event/TimerWheel.hpp"
 
 # define MAX_CLIENTS 1024
+# define MIN_ACCEPT_BUDGET 8    // accept() par réveil au minimum
+# define MAX_ACCEPT_BUDGET 512  // accept() par réveil au maximum
+# define LINGERING_TIMEOUT 5000 // ms accordées au client pour finir d'envoyer une requête refusée
 
 /**
  * @brief Serveur HTTP gérant les connexions clients et le traitement des requêtes
@@ -24,34 +29,54 @@ class Server
 	Socket server_socket;      // Socket principal du serveur
 	int port;                  // Port d'écoute
 	bool running;              // État d'exécution du serveur
+	int accept_budget;         // Nombre d'accept() par réveil, ajusté selon la file d'attente
+	std::string overload_response; // Réponse 503 préconstruite pour les connexions refusées
 	ServerConfig server_config; // Configuration du serveur
 	RouteHandler route_handler; // Gestionnaire de routes
-    std::map<int, std::string> client_requests; // Stockage des requêtes en cours par fd
 
 	// Méthodes privées
-	void sendHttpResponse(int client_fd, const HttpRequest& request); // Envoi d'une réponse HTTP
-    void processCompleteRequest(int client_fd, const std::string& raw_request); // Traitement d'une requête complète
+	bool processRequest(Connection& conn); // Traitement d'une requête reçue en entier, retourne false si la connexion doit être fermée
+	void answerExpectation(Connection& conn); // Envoie "100 Continue" ou refuse la requête avant son body
+	bool processPipeline(Connection& conn); // Traite dans l'ordre les requêtes complètes du tampon, retourne false si la connexion doit être fermée
+	void sendHttpResponse(Connection& conn, const HttpRequest& request); // Envoi d'une réponse HTTP
+	void queueResponse(Connection& conn, std::string& raw_response); // Mise en file d'une réponse et tentative d'envoi
+	void queueResponse(Connection& conn, HttpResponse& response); // Mise en file d'une réponse, body sans copie
+	bool flushOutput(Connection& conn); // Vide la file de sortie autant que possible, retourne false en cas d'erreur
+	bool startLingeringClose(Connection& conn); // Ferme l'écriture et jette la suite d'une requête refusée, retourne false si la connexion doit être fermée
+	bool discardClientData(Connection& conn); // Lit et jette les octets reçus pendant la fermeture différée
+	Connection::TimerPhase timerPhase(const Connection& conn) const; // Timeout applicable à l'état courant du client
+    void processCompleteRequest(Connection& conn, const std::string& raw_request); // Traitement d'une requête complète
 
   public:
 	Server(int port, const ServerConfig& config);
 	~Server();
 
     // Méthodes de contrôle
-    void initialize();         // Initialiser le socket du serveur
+    void initialize(bool reuse_port = false); // Initialiser le socket du serveur (SO_REUSEPORT en mode multi-workers)
     void stop();               // Arrêter le serveur
 
 	// Méthodes pour gérer les connections
 	int acceptNewConnection();  // Accepter une nouvelle connexion client, retourne le nouveau fd
-	bool handleClientData(int client_fd); // Traiter les données reçues d'un client, retourne false si la connexion doit être fermée
-    void closeClientConnection(int client_fd); // Ferme une connexion client
-    void handleClientTimeout(int client_fd); // Gère un timeout de client
+	void rejectConnection(int client_fd); // Répondre 503 et fermer une connexion en surcharge
+	int getAcceptBudget() const { return accept_budget; }
+	void adjustAcceptBudget(int accepted, bool drained); // Adapter le budget d'accept() à la file d'attente
+	bool handleClientData(Connection& conn); // Traiter les données reçues d'un client, retourne false si la connexion doit être fermée
+	bool handleClientWrite(Connection& conn); // Reprendre l'envoi quand le socket est inscriptible, retourne false si la connexion doit être fermée
+	int getClientEvents(const Connection& conn) const; // Événements (Poller::EVENT_*) à surveiller pour ce client
+    void closeClientConnection(Connection& conn); // Ferme le socket d'une connexion client
+    bool handleClientTimeout(Connection& conn); // Gère l'expiration du timer d'un client, retourne false si la connexion doit être fermée
+    void updateClientTimer(Connection& conn, TimerWheel& timers); // (Ré)arme le timeout correspondant à l'état du client
     
     // Accesseurs
     int getPort() const { return port; }
     int getSocketFd() const; // Récupérer le descripteur de fichier du socket serveur
     bool isRunning() const { return running; }
     bool matchesSocketFd(int fd) const; // Vérifier si le fd correspond au socket du serveur
+    int getWatchFd() const; // Descripteur inotify du cache de réponses (-1 si désactivé)
+    void handleFileEvents(); // Invalide les réponses en cache des fichiers modifiés
+    void reloadErrorPages(); // Relit les pages error_page (SIGHUP)
     const ServerConfig& getConfig() const { return server_config; }
+    size_t getMaxBodySize(const std::string& uri) const; // client_max_body_size de la location correspondant à l'URI
 };
 
 #endif
\ No newline at end of file
@@ -31,25 +31,54 @@ private:
      * @param location_path Le chemin de la location en cours
      * @param in_server Indicateur si on est dans un bloc server
      * @param in_location Indicateur si on est dans un bloc location
+     * @param in_types Indicateur si on est dans le bloc types
      * @param brace_level Niveau d'imbrication des accolades
      */
     void parseNewSyntax(const std::string& line, WebservConfig& config,
                      ServerConfig& current_server, LocationConfig& current_location,
                      std::string& location_path, bool& in_server, bool& in_location,
-                     int& brace_level);
+                     bool& in_types, int& brace_level);
+
+    /**
+     * @brief Ajoute une déclaration "type ext1 ext2;" aux types MIME
+     * @param statement Déclaration, le ';' final est facultatif
+     * @param mime_types Table extension -> type à compléter
+     * @throw std::runtime_error Si la déclaration est invalide
+     */
+    void addMimeTypes(const std::string& statement, std::map<std::string, std::string>& mime_types);
+
+    /**
+     * @brief Charge un fichier au format mime.types (celui de nginx : "types { ... }")
+     * @param path Chemin du fichier
+     * @param mime_types Table extension -> type à compléter
+     * @throw std::runtime_error Si le fichier est illisible ou invalide
+     */
+    void loadMimeTypesFile(const std::string& path, std::map<std::string, std::string>& mime_types);
 
     /**
      * @brief Parse une directive de configuration
      * @param line La ligne à parser
+     * @param config La configuration globale (directives hors bloc server)
      * @param in_server Indicateur si on est dans un bloc server
      * @param in_location Indicateur si on est dans un bloc location
      * @param server Le serveur en cours de configuration
      * @param location La location en cours de configuration
      * @throw std::runtime_error Si la directive est invalide
      */
-    void parseDirective(const std::string& line, bool in_server, bool in_location,
+    void parseDirective(const std::string& line, WebservConfig& config,
+                     bool in_server, bool in_location,
                      ServerConfig& server, LocationConfig& location);
 
+    /**
+     * @brief Traite une directive globale (hors de tout bloc server)
+     * @param key Clé de la directive
+     * @param value Valeur de la directive
+     * @param config Configuration globale à modifier
+     * @throw std::runtime_error Si la directive est invalide
+     */
+    void processGlobalDirective(const std::string& key, const std::string& value,
+                             WebservConfig& config);
+
     /**
      * @brief Traite une directive de serveur
      * @param key Clé de la directive
@@ -127,6 +156,7 @@ private:
     std::vector<std::string> split(const std::string& str, char delimiter);
     std::string trim(const std::string& str);
     size_t parseSize(const std::string& size_str);
+    unsigned long parseTime(const std::string& time_str);
     bool fileExists(const std::string& path);
     bool directoryExists(const std::string& path);
 };
@@ -20,11 +20,13 @@ struct LocationConfig {
     std::string upload_directory;              // Répertoire pour les uploads
     std::string alias;                         // Alias pour cette location
     size_t client_max_body_size;               // Taille maximale du body pour cette location
+    bool gzip_static;                          // Servir les variantes précompressées (.br, .gz) si acceptées
     
     LocationConfig() 
         : autoindex(false)
         , redirect_code(0)
-        , client_max_body_size(1024 * 1024) {} // 1MB par défaut
+        , client_max_body_size(1024 * 1024) // 1MB par défaut
+        , gzip_static(false) {}
 };
 
 /**
@@ -38,11 +40,35 @@ struct ServerConfig {
     std::vector<std::string> index_files;            // Fichiers index par défaut
     std::map<int, std::string> error_pages;          // Pages d'erreur personnalisées
     std::map<std::string, LocationConfig> locations; // Configurations des locations
+    unsigned long client_header_timeout;             // Délai max pour recevoir les en-têtes (ms)
+    unsigned long client_body_timeout;               // Délai max entre deux lectures du body (ms)
+    unsigned long keepalive_timeout;                 // Durée de vie d'une connexion keep-alive inactive (ms)
+    unsigned long send_timeout;                      // Délai max entre deux écritures de la réponse (ms)
+    size_t max_pipelined_requests;                   // Réponses en attente par connexion avant de suspendre la lecture
+    size_t open_file_cache;                          // Fichiers ouverts gardés en cache (0 = désactivé)
+    unsigned long open_file_cache_valid;             // Durée de validité d'une entrée du cache de fichiers (ms)
+    size_t response_cache;                           // Réponses statiques préconstruites en mémoire (0 = désactivé)
+    size_t response_cache_max_size;                  // Taille max d'un fichier mis en cache mémoire (octets)
+    bool gzip;                                       // Compression gzip à la volée des réponses textuelles
+    int gzip_comp_level;                             // Niveau de compression zlib (1 à 9)
+    size_t gzip_min_length;                          // Taille min d'un body pour être compressé (octets)
     
     ServerConfig() 
         : host("0.0.0.0")
         , port(0)
-        , root_directory("./www") {}
+        , root_directory("./www")
+        , client_header_timeout(60000)
+        , client_body_timeout(60000)
+        , keepalive_timeout(75000)
+        , send_timeout(60000)
+        , max_pipelined_requests(32)
+        , open_file_cache(0)
+        , open_file_cache_valid(60000)
+        , response_cache(0)
+        , response_cache_max_size(64 * 1024)
+        , gzip(false)
+        , gzip_comp_level(6)
+        , gzip_min_length(1024) {}
 };
 
 /**
@@ -50,6 +76,12 @@ struct ServerConfig {
  */
 struct WebservConfig {
     std::vector<ServerConfig> servers; // Liste des serveurs configurés
+    std::string event_backend;         // Backend d'événements: "epoll", "poll" ou vide (automatique)
+    int worker_processes;              // Nombre de processus workers (0 = auto, un par cœur)
+    std::map<std::string, std::string> mime_types; // Extension (minuscules, sans point) -> type, en plus des types intégrés
+    
+    WebservConfig()
+        : worker_processes(1) {}
 };
 
 #endif // CONFIG_TYPES_HPP 
\ No newline at end of file
@@ -0,0 +1,41 @@
+#ifndef EPOLL_POLLER_HPP
+#define EPOLL_POLLER_HPP
+
+#include "event/Poller.hpp"
+
+#if defined(__linux__) && !defined(WEBSERV_NO_EPOLL)
+# define WEBSERV_HAS_EPOLL 1
+#endif
+
+#ifdef WEBSERV_HAS_EPOLL
+
+# include <sys/epoll.h>
+# include <vector>
+
+/**
+ * @brief Backend epoll (Linux) : seuls les descripteurs prêts sont remontés
+ *
+ * Le coût d'un réveil est proportionnel au nombre d'événements et non plus
+ * au nombre total de connexions surveillées.
+ */
+class EpollPoller : public Poller {
+public:
+    EpollPoller();
+    virtual ~EpollPoller();
+
+    virtual bool add(int fd, int events, void* data);
+    virtual bool modify(int fd, int events, void* data);
+    virtual void remove(int fd);
+    virtual int wait(std::vector<PollEvent>& ready, int timeout_ms);
+    virtual const char* name() const { return "epoll"; }
+
+private:
+    int epoll_fd;
+    std::vector<struct epoll_event> events_buffer;  // Tampon de sortie de epoll_wait()
+
+    static unsigned int toEpollEvents(int events);
+};
+
+#endif // WEBSERV_HAS_EPOLL
+
+#endif // EPOLL_POLLER_HPP
@@ -0,0 +1,32 @@
+#ifndef POLL_POLLER_HPP
+#define POLL_POLLER_HPP
+
+#include "event/Poller.hpp"
+#include <poll.h>
+#include <vector>
+
+/**
+ * @brief Backend poll() portable, utilisé en repli quand epoll n'est pas disponible
+ *
+ * Le tableau pollfd est compacté à chaque suppression ; une table indexée par fd
+ * donne la position de chaque descripteur pour que modify/remove restent en O(1).
+ */
+class PollPoller : public Poller {
+public:
+    PollPoller();
+    virtual ~PollPoller();
+
+    virtual bool add(int fd, int events, void* data);
+    virtual bool modify(int fd, int events, void* data);
+    virtual void remove(int fd);
+    virtual int wait(std::vector<PollEvent>& ready, int timeout_ms);
+    virtual const char* name() const { return "poll"; }
+
+private:
+    std::vector<struct pollfd> poll_fds;  // Tableau passé à poll()
+    std::vector<int> fd_index;            // fd -> position dans poll_fds (-1 si absent)
+
+    static short toPollEvents(int events);
+};
+
+#endif // POLL_POLLER_HPP
@@ -0,0 +1,77 @@
+#ifndef POLLER_HPP
+#define POLLER_HPP
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief Événement prêt renvoyé par Poller::wait()
+ */
+struct PollEvent {
+    int fd;         // Descripteur concerné
+    int events;     // Combinaison de Poller::EVENT_*
+    void* data;     // Donnée utilisateur associée au fd (Server*, connexion...)
+};
+
+/**
+ * @brief Interface commune des backends de multiplexage d'E/S (poll, epoll)
+ *
+ * Chaque fd enregistré possède un pointeur utilisateur stocké dans une table
+ * indexée par fd : un événement donne donc directement accès à son
+ * propriétaire, sans recherche dans une std::map. Seuls les descripteurs
+ * prêts sont renvoyés par wait().
+ */
+class Poller {
+public:
+    enum {
+        EVENT_READ  = 1 << 0,
+        EVENT_WRITE = 1 << 1,
+        EVENT_ERROR = 1 << 2   // Erreur ou fermeture (POLLERR/POLLHUP, EPOLLERR/EPOLLHUP)
+    };
+
+    virtual ~Poller() {}
+
+    /**
+     * @brief Crée le backend demandé ("epoll", "poll" ou "" pour le meilleur disponible)
+     * @return Le backend, ou le backend poll si celui demandé n'est pas disponible
+     */
+    static Poller* create(const std::string& backend);
+
+    // Gestion des descripteurs surveillés
+    virtual bool add(int fd, int events, void* data) = 0;
+    virtual bool modify(int fd, int events, void* data) = 0;
+    virtual void remove(int fd) = 0;
+
+    /**
+     * @brief Attend des événements
+     * @param ready Vecteur rempli avec les seuls descripteurs prêts
+     * @param timeout_ms Timeout en millisecondes (-1 = infini)
+     * @return Le nombre d'événements, ou -1 en cas d'erreur (errno positionné)
+     */
+    virtual int wait(std::vector<PollEvent>& ready, int timeout_ms) = 0;
+
+    virtual const char* name() const = 0;
+
+    // Accès à la table fd -> donnée utilisateur / événements surveillés
+    void* getData(int fd) const;
+    int getEvents(int fd) const;
+    bool isRegistered(int fd) const { return getData(fd) != NULL; }
+    size_t size() const { return registered; }
+    int maxFd() const { return static_cast<int>(fd_data.size()) - 1; }
+
+protected:
+    Poller() : registered(0) {}
+
+    void setData(int fd, void* data, int events);
+    void clearData(int fd);
+
+private:
+    std::vector<void*> fd_data;  // Donnée utilisateur indexée par fd
+    std::vector<int> fd_events;  // Événements surveillés indexés par fd
+    size_t registered;           // Nombre de fds enregistrés
+
+    Poller(const Poller&);
+    Poller& operator=(const Poller&);
+};
+
+#endif // POLLER_HPP
@@ -0,0 +1,73 @@
+#ifndef TIMER_WHEEL_HPP
+#define TIMER_WHEEL_HPP
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Roue de timers hiérarchique indexée par fd
+ *
+ * Quatre niveaux (256 + 3 x 64 slots). Armer, réarmer ou annuler un timer est
+ * en O(1) : chaque fd possède un nœud intrusif chaîné dans le slot de son
+ * échéance. Les timers lointains descendent d'un niveau (cascade) quand la
+ * roue inférieure fait un tour complet.
+ */
+class TimerWheel {
+public:
+    explicit TimerWheel(unsigned long tick_ms = 100);
+
+    /**
+     * @brief Arme (ou réarme) le timer d'un fd
+     * @param timeout_ms Délai avant expiration à partir de maintenant
+     */
+    void schedule(int fd, unsigned long timeout_ms);
+    void cancel(int fd);
+    bool isScheduled(int fd) const;
+
+    /**
+     * @brief Fait avancer la roue jusqu'à l'instant présent
+     * @param expired Rempli avec les fds dont le timer a expiré (désarmés)
+     */
+    void advance(std::vector<int>& expired);
+
+    /**
+     * @brief Délai en ms à passer à poll()/epoll_wait() (-1 si aucun timer)
+     */
+    int nextTimeout() const;
+
+    size_t size() const { return count; }
+
+    static unsigned long nowMs(); // Horloge monotone en millisecondes
+
+private:
+    enum {
+        ROOT_BITS = 8,
+        LEVEL_BITS = 6,
+        ROOT_SIZE = 1 << ROOT_BITS,
+        LEVEL_SIZE = 1 << LEVEL_BITS,
+        LEVELS = 3,   // Niveaux au-dessus de la racine
+        SLOT_COUNT = ROOT_SIZE + LEVELS * LEVEL_SIZE
+    };
+
+    struct Node {
+        int prev;
+        int next;
+        int slot;                 // -1 si le timer n'est pas armé
+        unsigned long expires;    // Échéance en ticks absolus
+        Node() : prev(-1), next(-1), slot(-1), expires(0) {}
+    };
+
+    unsigned long tick_ms;
+    unsigned long current_tick;   // Dernier tick traité
+    unsigned long origin_ms;      // Instant correspondant au tick 0
+    std::vector<Node> nodes;      // Nœuds indexés par fd
+    int heads[SLOT_COUNT];        // Tête de liste de chaque slot (-1 = vide)
+    size_t count;                 // Nombre de timers armés
+
+    void link(int fd);
+    void unlink(int fd);
+    void cascade(int level, unsigned long index);
+    unsigned long tickFor(unsigned long ms) const;
+};
+
+#endif // TIMER_WHEEL_HPP
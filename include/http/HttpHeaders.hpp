@@ -0,0 +1,74 @@
+#ifndef HTTP_HEADERS_HPP
+#define HTTP_HEADERS_HPP
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+/**
+ * @brief Identifiants des en-têtes de requête courants
+ */
+enum HttpHeaderId {
+    HEADER_HOST,
+    HEADER_CONNECTION,
+    HEADER_CONTENT_LENGTH,
+    HEADER_CONTENT_TYPE,
+    HEADER_TRANSFER_ENCODING,
+    HEADER_EXPECT,
+    HEADER_COOKIE,
+    HEADER_IF_NONE_MATCH,
+    HEADER_IF_MODIFIED_SINCE,
+    HEADER_IF_RANGE,
+    HEADER_RANGE,
+    HEADER_ACCEPT,
+    HEADER_ACCEPT_ENCODING,
+    HEADER_USER_AGENT,
+    HEADER_REFERER,
+    HEADER_AUTHORIZATION,
+    HEADER_COUNT,               // Nombre d'en-têtes connus
+    HEADER_OTHER = HEADER_COUNT // En-tête quelconque, recherché par nom
+};
+
+/**
+ * @brief Table plate des en-têtes d'une requête
+ *
+ * Les en-têtes sont stockés dans l'ordre de réception (nom en minuscules).
+ * Les en-têtes connus reçoivent un identifiant à l'insertion : les retrouver
+ * est un simple accès indexé. Les autres sont retrouvés par un parcours
+ * linéaire, sans jamais allouer ni convertir le nom recherché.
+ */
+class HttpHeaders {
+public:
+    struct Entry {
+        HttpHeaderId id;
+        std::string name;   // Nom en minuscules
+        std::string value;
+    };
+
+    HttpHeaders();
+
+    /**
+     * @brief Ajoute un en-tête ; une seconde occurrence remplace la première
+     */
+    void set(const char* name, size_t name_len, const char* value, size_t value_len);
+    void clear();
+
+    // Recherche insensible à la casse, sans allocation (NULL si absent)
+    const std::string* find(HttpHeaderId id) const;
+    const std::string* find(const char* name, size_t name_len) const;
+
+    size_t size() const { return entries.size(); }
+    bool empty() const { return entries.empty(); }
+    const Entry& operator[](size_t i) const { return entries[i]; }
+
+    /**
+     * @brief Identifiant d'un nom d'en-tête (HEADER_OTHER s'il n'est pas connu)
+     */
+    static HttpHeaderId lookupId(const char* name, size_t name_len);
+
+private:
+    std::vector<Entry> entries;
+    int known[HEADER_COUNT]; // Position des en-têtes connus dans entries (-1 si absent)
+};
+
+#endif // HTTP_HEADERS_HPP
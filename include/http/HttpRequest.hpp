@@ -2,9 +2,11 @@
 #define HTTP_REQUEST_HPP
 
 #include "http/parser/FormData.hpp"
+#include "http/parser/RequestParser.hpp"
+#include "http/HttpHeaders.hpp"
 #include <string>
 #include <map>
-#include <algorithm>
+#include <cstring>
 
 /**
  * @brief Classe représentant une requête HTTP | But: parser la requête HTTP et stocker les données dans les variables membres
@@ -21,6 +23,8 @@ public:
     // Méthodes principales
     void clear();
     bool parse(const std::string& raw_request);
+    bool parse(const char* data, size_t size, const RequestParser& parser,
+               std::string* decoded_body = NULL); // Construit la requête depuis un parsing déjà fait (body chunked déjà décodé, repris sans copie)
     void setMaxBodySize(size_t size) { max_body_size = size; }
     size_t getMaxBodySize() const { return max_body_size; }
 
@@ -30,23 +34,17 @@ public:
     const std::string& getVersion() const { return version; }
     const std::string& getBody() const { return body; }
     const std::string& getQueryString() const { return query_string; }
-    const std::map<std::string, std::string>& getHeaders() const { return headers; }
+    const HttpHeaders& getHeaders() const { return headers; }
     
     // Getters pour les codes d'erreur
     int getErrorCode() const { return error_code; }
     const std::string& getErrorMessage() const { return error_message; }
     
-    // Récupérer une en-tête spécifique
-    std::string getHeader(const std::string& name) const {
-        std::string lowercase_name = name;
-        // Convertir en minuscules pour la recherche
-        std::transform(lowercase_name.begin(), lowercase_name.end(), lowercase_name.begin(), ::tolower);
-        
-        std::map<std::string, std::string>::const_iterator it = headers.find(lowercase_name);
-        if (it != headers.end())
-            return it->second;
-        return "";
-    }
+    // Récupérer une en-tête spécifique (insensible à la casse, chaîne vide si absente)
+    const std::string& getHeader(HttpHeaderId id) const { return headerOrEmpty(headers.find(id)); }
+    const std::string& getHeader(const char* name) const { return headerOrEmpty(headers.find(name, strlen(name))); }
+    const std::string& getHeader(const std::string& name) const { return headerOrEmpty(headers.find(name.data(), name.size())); }
+    bool hasHeader(HttpHeaderId id) const { return headers.find(id) != NULL; }
     
     // Getters pour les formulaires et fichiers (délégués à FormData)
     const FormData& getFormData() const { return form_data; }
@@ -57,9 +55,9 @@ public:
     const UploadedFile* getUploadedFile(const std::string& name) const { return form_data.getUploadedFile(name); }
 
 private:
+    static const std::string& headerOrEmpty(const std::string* value);
+    
     // Méthodes de parsing
-    bool parseRequestLine(const std::string& line);
-    bool parseHeaders(const std::string& headers_section);
     void parseQueryString();
     void parseFormBody();
     std::string extractBoundary(const std::string& content_type) const; // Extraire le boundary d'un content-type multipart
@@ -71,7 +69,7 @@ private:
     std::string method;      // GET, POST, DELETE
     std::string uri;         // /index.html
     std::string version;     // HTTP/1.1
-    std::map<std::string, std::string> headers;
+    HttpHeaders headers;     // En-têtes, noms en minuscules
     std::string body;
     std::string query_string; // Paramètres après le ? dans l'URI
     
@@ -3,11 +3,25 @@
 
 #include <string>
 #include <map>
+#include <vector>
 #include <sstream>
+#include <sys/types.h>
+#include <ctime>
+#include "http/utils/FileHandle.hpp"
+#include "http/utils/SharedBuffer.hpp"
 
 // Forward declaration
 class HttpRequest;
 
+/**
+ * @brief Partie d'un body multipart lu dans un fichier : en-têtes de la partie puis portion du fichier
+ */
+struct FilePart {
+    std::string head;   // Délimiteur et en-têtes de la partie (ou délimiteur final)
+    off_t offset;
+    size_t length;      // 0 pour le délimiteur final
+};
+
 /**
  * @brief Classe représentant une réponse HTTP
  */
@@ -21,6 +35,10 @@ public:
     void setStatus(int code, const std::string& message = "");
     void setHeader(const std::string& key, const std::string& value);
     void setBody(const std::string& content, const std::string& content_type = "text/html");
+    void setBody(const SharedBuffer& content, const std::string& content_type); // Body partagé, sans copie
+    void setFileBody(const FileHandle& file, off_t offset, size_t length, const std::string& content_type);
+    void setFileParts(const FileHandle& file, const std::vector<FilePart>& parts, const std::string& content_type);
+    void setPrebuilt(int code, const SharedBuffer& raw); // En-têtes et body déjà sérialisés (buildPrebuilt())
 
     // Méthodes pour les cas spéciaux de réponses
     void setNotModified(const std::string& etag);
@@ -33,6 +51,10 @@ public:
     // Méthodes pour construire la réponse finale
     std::string build() const;
     std::string buildHeadResponse() const;
+    std::string buildPrebuilt() const; // En-têtes et body sans ligne de statut ni Date (cache)
+    void serializeHeaders(std::string& out) const; // Ligne de statut et en-têtes ajoutés à out, sans le body
+    void serializeStatusLine(std::string& out) const; // Ligne de statut et Date seulement
+    void takeBody(std::string& out) { out.swap(body); } // Transfère le body sans copie (la réponse n'en a plus)
 
     // Getters
     int getStatus() const { return status_code; }
@@ -45,6 +67,21 @@ public:
     const std::map<std::string, std::string>& getHeaders() const { return headers; }
     const std::string& getBody() const { return body; }
 
+    // Body lu dans un fichier ouvert, envoyé par sendfile() sans passer en mémoire
+    bool hasFileBody() const { return file_body.isOpen(); }
+    const FileHandle& getFileBody() const { return file_body; }
+    off_t getFileOffset() const { return file_offset; }
+    size_t getFileLength() const { return file_length; }
+    const std::vector<FilePart>& getFileParts() const { return file_parts; } // multipart/byteranges
+
+    // Body partagé (pages d'erreur, cache gzip), envoyé sans copie après les en-têtes
+    bool hasSharedBody() const { return !shared_body.empty(); }
+    const SharedBuffer& getSharedBody() const { return shared_body; }
+
+    // Réponse préconstruite, envoyée telle quelle après la ligne de statut (en-têtes et body de l'objet ignorés)
+    bool hasPrebuilt() const { return !prebuilt.empty(); }
+    const SharedBuffer& getPrebuilt() const { return prebuilt; }
+
     // Méthodes statiques pour créer des réponses spécifiques
     static HttpResponse createError(int error_code, const std::string& message = "");
 
@@ -53,11 +90,21 @@ private:
     std::string status_message;
     std::map<std::string, std::string> headers;
     std::string body;
+    FileHandle file_body;   // Body fichier (prioritaire sur body s'il est ouvert)
+    off_t file_offset;
+    size_t file_length;
+    std::vector<FilePart> file_parts; // Plusieurs portions du fichier (remplacent offset et length)
+    SharedBuffer prebuilt;  // En-têtes et body partagés avec le cache
+    SharedBuffer shared_body; // Body partagé (remplace body s'il n'est pas vide)
+
+    void serializeFields(std::string& out) const;
+    void appendFieldsAndBody(std::string& out) const;
 };
 
 // Fonctions utilitaires pour les réponses HTTP
-std::string getMimeType(const std::string& file_path);
+const std::string& getMimeType(const std::string& file_path); // Chaîne de la table MimeTypes, sans allocation
 std::string calculateETag(const std::string& file_path);
+std::string calculateETag(off_t size, time_t mtime);
 bool checkNotModified(const HttpRequest& request, const std::string& file_path, HttpResponse& response);
 
 #endif // HTTP_RESPONSE_HPP 
\ No newline at end of file
@@ -5,10 +5,37 @@
 #include "http/HttpResponse.hpp"
 #include "http/upload/FileUploadHandler.hpp"
 #include "http/upload/UploadConfig.hpp"
+#include "http/utils/OpenFileCache.hpp"
+#include "http/utils/ResponseCache.hpp"
+#include "http/utils/GzipEncoder.hpp"
+#include "http/utils/ErrorPages.hpp"
 #include "config/ConfigTypes.hpp"
 #include <string>
 #include <map>
 
+// Codages des variantes précompressées (gzip_static)
+#define ENCODING_GZIP 0x1
+#define ENCODING_BR   0x2
+
+/**
+ * @brief Ressource statique résolue une fois par requête
+ *
+ * Le fstat() (ou l'entrée du cache de fichiers ouverts, qui porte aussi
+ * Last-Modified déjà formaté), le type MIME et l'ETag sont établis une
+ * seule fois, puis lus par chaque étape : validation du cache, plages,
+ * en-têtes de la réponse.
+ */
+struct StaticResource {
+    std::string path;           // Fichier demandé (l'index pour un répertoire)
+    std::string body_path;      // Fichier envoyé : path ou sa variante précompressée
+    FileInfo info;              // Métadonnées et fd du fichier envoyé
+    std::string encoding;       // Content-Encoding de la représentation ("" : aucun)
+    const std::string* mime_type; // Type du fichier demandé (table MimeTypes), même pour une variante compressée
+    std::string etag;
+
+    StaticResource() : mime_type(NULL) {}
+};
+
 /**
  * @brief Classe pour traiter les requêtes HTTP et générer les réponses appropriées
  */
@@ -17,7 +44,10 @@ public:
     // Constructeur et destructeur
     RouteHandler(const std::string& root, const ServerConfig& config)
         : root_directory(root)
-        , server_config(config) {}
+        , server_config(config)
+        , open_files(config.open_file_cache, config.open_file_cache_valid)
+        , response_cache(config.response_cache, config.response_cache_max_size)
+        , gzip_encoder(config.gzip_comp_level, config.gzip_min_length) {}
     virtual ~RouteHandler() {}
 
     // Méthode principale pour traiter les requêtes
@@ -26,18 +56,39 @@ public:
     // Méthode pour trouver la location correspondante à une URI
     const LocationConfig* findMatchingLocation(const std::string& uri) const;
 
+    // Vérifie la méthode pour l'URI dès les en-têtes reçus, avant le body (0 si acceptée)
+    int checkMethod(const std::string& method, const std::string& uri) const;
+
     // Méthodes de gestion du cache
-    bool checkNotModified(const HttpRequest& request, const std::string& file_path, HttpResponse& response);
+    bool checkNotModified(const HttpRequest& request, const StaticResource& resource, HttpResponse& response);
     HttpResponse serveErrorPage(int error_code, const std::string& message);
+    size_t loadErrorPages(); // (Re)lit les pages error_page en mémoire
+
+    // Cache des réponses statiques préconstruites
+    ResponseCache& getResponseCache() { return response_cache; }
+    const ResponseCache& getResponseCache() const { return response_cache; }
+    void handleFileEvents(); // Invalide les entrées des fichiers modifiés (événements inotify)
 
 private:
     // Répertoire racine pour les fichiers statiques
     std::string root_directory;
     // Configuration du serveur
     const ServerConfig& server_config;
+    // Fichiers ouverts et métadonnées des ressources statiques
+    OpenFileCache open_files;
+    // Réponses complètes des petits fichiers statiques
+    ResponseCache response_cache;
+    // Compression à la volée et fichiers déjà compressés
+    GzipEncoder gzip_encoder;
+    // Bodies des pages d'erreur, préchargés
+    ErrorPages error_pages;
 
     // Méthodes de traitement par type de requête
-    HttpResponse handleGetRequest(const HttpRequest& request);
+    HttpResponse routeRequest(const HttpRequest& request);
+    void compressResponse(const HttpRequest& request, HttpResponse& response);
+    HttpResponse handleGetRequest(const HttpRequest& request, const std::string& file_path,
+                                  const LocationConfig* location);
+    bool serveCachedResponse(const HttpRequest& request, const std::string& key, HttpResponse& response);
     /**
      * @brief Traite une requête POST
      * 
@@ -55,7 +106,16 @@ private:
     bool isCgiResource(const std::string& path) const;
     std::string getFilePath(const std::string& uri, bool log = true) const;
     bool serveStaticFile(const std::string& file_path, HttpResponse& response);
+    bool serveStaticFile(const StaticResource& resource, HttpResponse& response);
+    static void describeResource(StaticResource& resource);
+    bool serveRanges(const HttpRequest& request, const StaticResource& resource, HttpResponse& response);
+    static bool ifRangeMatches(const std::string& if_range, const StaticResource& resource);
+    std::string findPrecompressed(const std::string& file_path, int encodings, std::string& body_path, FileInfo& info);
+    int acceptedEncodings(const HttpRequest& request, const LocationConfig* location) const;
+    static std::string responseCacheKey(const std::string& file_path, int encodings);
+    static std::string representationETag(const FileInfo& info, const std::string& encoding);
     bool isCGIRequest(const std::string& path, const LocationConfig& location) const;
+    static bool isMethodAllowed(const LocationConfig& location, const std::string& method);
     std::string getFileExtension(const std::string& path) const;
     
     static std::map<std::string, std::string> create_interpreter_map();
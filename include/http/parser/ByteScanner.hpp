@@ -0,0 +1,34 @@
+#ifndef BYTE_SCANNER_HPP
+#define BYTE_SCANNER_HPP
+
+#include <string>
+#include <cstddef>
+
+/**
+ * @brief Recherche de séquences dans les tampons HTTP
+ *
+ * Les tampons sont parcourus 16 octets à la fois avec SSE2 (toujours
+ * disponible en x86-64), puis octet par octet pour la fin du tampon (et
+ * sur les autres architectures). La recherche d'un seul octet (fins de
+ * ligne, ':') reste confiée à memchr() : celui de la glibc choisit déjà
+ * à l'exécution la meilleure version vectorisée du processeur.
+ */
+namespace ByteScanner {
+
+/**
+ * @brief Position de la première occurrence de needle dans [from, size)
+ *
+ * Les candidats sont repérés en comparant en parallèle le premier et le
+ * dernier octet de needle ; seuls ceux-là sont vérifiés en entier.
+ * @return La position, ou std::string::npos si absente
+ */
+size_t findSequence(const char* data, size_t size, size_t from, const char* needle, size_t needle_size);
+
+/**
+ * @brief Jeu d'instructions utilisé ("sse2" ou "scalar")
+ */
+const char* implementation();
+
+} // namespace ByteScanner
+
+#endif // BYTE_SCANNER_HPP
@@ -0,0 +1,65 @@
+#ifndef CHUNKED_DECODER_HPP
+#define CHUNKED_DECODER_HPP
+
+#include <string>
+#include <cstddef>
+
+#define MAX_CHUNK_LINE_SIZE 4096 // Taille maximale d'une ligne de taille (extensions incluses) ou de trailer
+
+/**
+ * @brief Décodeur incrémental de Transfer-Encoding: chunked
+ *
+ * Les octets encodés sont décodés au fil de leur arrivée : l'appelant peut
+ * libérer les octets consommés aussitôt, seul le body décodé est conservé.
+ * La limite client_max_body_size est vérifiée pendant le décodage, sans
+ * attendre la fin du flux.
+ */
+class ChunkedDecoder {
+public:
+    enum Result {
+        DECODE_AGAIN,     // Flux incomplet, rappeler decode() avec la suite
+        DECODE_DONE,      // Dernier chunk et trailers reçus
+        DECODE_ERROR      // Flux invalide ou body trop grand (voir getErrorCode())
+    };
+
+    ChunkedDecoder();
+
+    void reset();
+    void setMaxBodySize(size_t size) { max_body_size = size; }
+
+    /**
+     * @brief Décode les octets disponibles
+     * @param data Octets encodés non encore consommés
+     * @param size Nombre d'octets disponibles
+     * @param consumed Nombre d'octets encodés consommés (à retirer du tampon par l'appelant)
+     * @param body Reçoit les octets décodés (ajoutés en fin)
+     */
+    Result decode(const char* data, size_t size, size_t& consumed, std::string& body);
+
+    int getErrorCode() const { return error_code; }
+    size_t getDecodedSize() const { return decoded_size; }
+
+private:
+    enum State {
+        STATE_SIZE,        // Chiffres hexadécimaux de la taille
+        STATE_EXTENSION,   // Extensions de chunk (ignorées) jusqu'à la fin de ligne
+        STATE_DATA,        // Données du chunk
+        STATE_DATA_END,    // \r\n après les données
+        STATE_TRAILER,     // Trailers après le dernier chunk, jusqu'à une ligne vide
+        STATE_DONE,
+        STATE_ERROR
+    };
+
+    State state;
+    size_t chunk_size;      // Taille du chunk courant
+    size_t remaining;       // Octets restants dans le chunk courant
+    size_t line_length;     // Longueur de la ligne en cours (taille ou trailer)
+    bool size_digits;       // Au moins un chiffre lu pour la taille
+    size_t decoded_size;
+    size_t max_body_size;
+    int error_code;
+
+    Result fail(int code);
+};
+
+#endif // CHUNKED_DECODER_HPP
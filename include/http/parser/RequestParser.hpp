@@ -0,0 +1,135 @@
+#ifndef REQUEST_PARSER_HPP
+#define REQUEST_PARSER_HPP
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+#define MAX_HEADERS_SIZE (32 * 1024) // Taille maximale de la ligne de requête et des en-têtes
+
+/**
+ * @brief Portion du tampon de réception (position et longueur), sans copie
+ */
+struct Span {
+    size_t offset;
+    size_t length;
+
+    Span() : offset(0), length(0) {}
+    Span(size_t offset, size_t length) : offset(offset), length(length) {}
+
+    bool empty() const { return length == 0; }
+    std::string str(const char* base) const { return std::string(base + offset, length); }
+};
+
+/**
+ * @brief En-tête repéré dans le tampon : nom et valeur (espaces de bord exclus)
+ */
+struct HeaderSpan {
+    Span name;
+    Span value;
+};
+
+/**
+ * @brief Parser HTTP/1.1 incrémental travaillant directement dans le tampon de réception
+ *
+ * feed() reçoit le tampon accumulé depuis le début de la requête et reprend
+ * l'analyse là où l'appel précédent s'était arrêté : les données peuvent
+ * arriver découpées n'importe où, y compris au milieu d'un \r\n. Aucune
+ * copie n'est faite, le parser ne retient que des positions (Span) ; le
+ * tampon peut donc être réalloué entre deux appels.
+ */
+class RequestParser {
+public:
+    enum State {
+        STATE_REQUEST_LINE,  // Attente de la ligne de requête
+        STATE_HEADERS,       // Lecture des en-têtes
+        STATE_BODY,          // En-têtes terminés, attente du body (Content-Length ou chunked)
+        STATE_COMPLETE,      // Requête complète
+        STATE_ERROR          // Requête invalide (voir getErrorCode())
+    };
+
+    enum Result {
+        PARSE_AGAIN,     // Données insuffisantes, rappeler feed() après le prochain recv()
+        PARSE_COMPLETE,  // Requête complète
+        PARSE_ERROR      // Requête invalide
+    };
+
+    RequestParser();
+
+    /**
+     * @brief Fait avancer l'analyse
+     * @param data Début de la requête dans le tampon de réception
+     * @param size Nombre d'octets disponibles depuis data
+     */
+    Result feed(const char* data, size_t size);
+
+    void reset();
+
+    /**
+     * @brief Termine une requête dont le body chunked a été décodé hors du tampon
+     */
+    void completeBody() { if (state == STATE_BODY) state = STATE_COMPLETE; }
+
+    /**
+     * @brief Marque la requête comme invalide (erreur détectée pendant le body)
+     */
+    void setError(int code) { fail(code); }
+
+    // État
+    State getState() const { return state; }
+    bool isComplete() const { return state == STATE_COMPLETE; }
+    bool headersComplete() const { return state == STATE_BODY || state == STATE_COMPLETE; }
+    int getErrorCode() const { return error_code; }
+
+    // Positions dans le tampon
+    const Span& getMethod() const { return method; }
+    const Span& getTarget() const { return target; }
+    const Span& getVersion() const { return version; }
+    const std::vector<HeaderSpan>& getHeaders() const { return headers; }
+    size_t getHeadersEnd() const { return headers_end; }           // Début du body
+    bool hasContentLength() const { return has_content_length; }
+    size_t getContentLength() const { return content_length; }
+    bool isChunked() const { return chunked; }
+
+    /**
+     * @brief Taille de la requête dans le tampon
+     *
+     * Un body chunked est décodé et retiré du tampon au fil de l'eau : seuls
+     * les en-têtes y restent.
+     */
+    size_t getRequestSize() const { return headers_end + (chunked ? 0 : content_length); }
+
+    /**
+     * @brief Recherche un en-tête (nom insensible à la casse)
+     * @return Le Span de la valeur, ou NULL si l'en-tête est absent
+     */
+    const HeaderSpan* findHeader(const char* data, const char* name) const;
+
+    /**
+     * @brief Compare un Span à une chaîne sans tenir compte de la casse
+     */
+    static bool equalsIgnoreCase(const char* data, const Span& span, const char* str);
+
+private:
+    State state;
+    size_t line_start;      // Début de la ligne en cours d'analyse
+    size_t scan_pos;        // Position où reprendre la recherche de fin de ligne
+    int error_code;
+
+    Span method;
+    Span target;
+    Span version;
+    std::vector<HeaderSpan> headers;
+    size_t headers_end;
+    bool has_content_length;
+    size_t content_length;
+    bool chunked;           // Transfer-Encoding: chunked
+
+    Result fail(int code);
+    bool parseRequestLine(const char* data, size_t start, size_t end);
+    bool parseHeaderLine(const char* data, size_t start, size_t end);
+    bool parseContentLength(const char* data, const Span& value);
+    int parseTransferEncoding(const char* data, const Span& value);
+};
+
+#endif // REQUEST_PARSER_HPP
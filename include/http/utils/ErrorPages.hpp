@@ -0,0 +1,57 @@
+#ifndef ERROR_PAGES_HPP
+#define ERROR_PAGES_HPP
+
+#include "http/utils/SharedBuffer.hpp"
+#include <string>
+#include <vector>
+#include <map>
+
+#define MAX_DEFAULT_PAGES_PER_CODE 16 // Messages distincts retenus par code pour les pages par défaut
+
+/**
+ * @brief Bodies des pages d'erreur, lus et construits une fois
+ *
+ * Les pages error_page sont chargées au démarrage (et rechargées sur
+ * SIGHUP) ; les pages par défaut sont construites au premier usage de
+ * chaque couple code/message. Une erreur ne coûte plus ni accès disque ni
+ * concaténation HTML : la réponse référence le tampon partagé, seuls la
+ * ligne de statut et les en-têtes sont sérialisés.
+ */
+class ErrorPages {
+public:
+    struct Page {
+        SharedBuffer body;
+        const std::string* content_type; // Chaîne de la table MimeTypes
+    };
+
+    ErrorPages();
+
+    /**
+     * @brief (Re)charge les pages configurées
+     * @param root Répertoire racine du serveur
+     * @param error_pages Code -> chemin relatif à root
+     * @return Nombre de pages chargées ; une page illisible garde la page par défaut
+     */
+    size_t load(const std::string& root, const std::map<int, std::string>& error_pages);
+
+    /**
+     * @brief Page configurée pour ce code, NULL s'il n'y en a pas
+     */
+    const Page* find(int code) const;
+
+    /**
+     * @brief Page par défaut (HttpResponse::createError()) pour ce code et ce message
+     */
+    SharedBuffer defaultPage(int code, const std::string& message);
+
+private:
+    struct DefaultPage {
+        std::string message;
+        SharedBuffer body;
+    };
+
+    std::map<int, Page> pages;
+    std::map<int, std::vector<DefaultPage> > defaults;
+};
+
+#endif // ERROR_PAGES_HPP
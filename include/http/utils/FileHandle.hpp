@@ -0,0 +1,32 @@
+#ifndef FILE_HANDLE_HPP
+#define FILE_HANDLE_HPP
+
+/**
+ * @brief Descripteur de fichier partagé, fermé à la dernière référence
+ *
+ * Une réponse dont le body est un fichier garde le fd ouvert jusqu'à la fin
+ * de son envoi, même si d'autres réponses (ou un cache) le partagent.
+ * Copier un FileHandle ne duplique pas le fd : le compteur de références
+ * est incrémenté.
+ */
+class FileHandle {
+public:
+    FileHandle();
+    explicit FileHandle(int fd); // Prend possession de fd
+    FileHandle(const FileHandle& other);
+    FileHandle& operator=(const FileHandle& other);
+    ~FileHandle();
+
+    int fd() const { return shared ? shared->fd : -1; }
+    bool isOpen() const { return shared != 0; }
+    void reset(); // Abandonne la référence (fermeture si c'était la dernière)
+
+private:
+    struct Shared {
+        int fd;
+        int refs;
+    };
+    Shared* shared;
+};
+
+#endif // FILE_HANDLE_HPP
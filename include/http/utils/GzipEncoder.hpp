@@ -0,0 +1,68 @@
+#ifndef GZIP_ENCODER_HPP
+#define GZIP_ENCODER_HPP
+
+#include "http/utils/FileHandle.hpp"
+#include "http/utils/SharedBuffer.hpp"
+#include <string>
+#include <list>
+#include <map>
+#include <cstddef>
+
+#define GZIP_MAX_STATIC_SIZE (4 * 1024 * 1024)  // Au-delà, un fichier statique part non compressé par sendfile()
+#define GZIP_CACHE_MAX_BYTES (16 * 1024 * 1024) // Mémoire max des fichiers compressés gardés en cache
+
+/**
+ * @brief Compression gzip (zlib) des réponses textuelles
+ *
+ * Seuls les types qui gagnent à être compressés (HTML, CSS, JSON,
+ * JavaScript) et les bodies d'au moins gzip_min_length octets sont
+ * compressés. Le résultat d'un fichier statique est gardé en cache sous
+ * son chemin et son ETag : chaque version d'un fichier n'est compressée
+ * qu'une fois, une nouvelle version change d'ETag et donc de clé. Le
+ * tampon du cache est partagé avec les réponses, jamais recopié.
+ */
+class GzipEncoder {
+public:
+    GzipEncoder(int level, size_t min_length);
+
+    /**
+     * @brief Le body mérite-t-il d'être compressé (type et taille)
+     */
+    bool shouldCompress(const std::string& content_type, size_t size) const;
+
+    /**
+     * @brief Compresse un bloc en un flux gzip complet
+     * @return false si zlib échoue (out est alors vide)
+     */
+    bool compress(const char* data, size_t size, std::string& out) const;
+
+    /**
+     * @brief Version compressée d'un fichier statique, depuis le cache si elle existe
+     * @param key Chemin du fichier
+     * @param etag ETag de la version lue
+     * @param out Reçoit le body compressé (référence au tampon du cache)
+     */
+    bool compressFile(const std::string& key, const std::string& etag,
+                      const FileHandle& file, size_t size, SharedBuffer& out);
+
+    size_t cachedBytes() const { return cached_bytes; }
+
+private:
+    struct Entry {
+        std::string key;  // Chemin et ETag
+        SharedBuffer data; // Body compressé
+    };
+    typedef std::list<Entry> EntryList;
+
+    int level;
+    size_t min_length;
+    EntryList entries;                             // Du plus récemment utilisé au plus ancien
+    std::map<std::string, EntryList::iterator> index;
+    size_t cached_bytes;
+
+    // Non copiable : l'index pointe dans la liste
+    GzipEncoder(const GzipEncoder&);
+    GzipEncoder& operator=(const GzipEncoder&);
+};
+
+#endif // GZIP_ENCODER_HPP
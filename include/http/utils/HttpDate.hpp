@@ -0,0 +1,35 @@
+#ifndef HTTP_DATE_HPP
+#define HTTP_DATE_HPP
+
+#include <string>
+#include <ctime>
+
+/**
+ * @brief Dates HTTP (IMF-fixdate, RFC 9110 §5.6.7)
+ *
+ * L'en-tête Date de chaque réponse vient d'une chaîne formatée au plus une
+ * fois par seconde : la boucle d'événements appelle update() à chaque
+ * réveil, les réponses ne font que la lire.
+ */
+namespace HttpDate {
+
+/**
+ * @brief Formate une date : "Sun, 06 Nov 1994 08:49:37 GMT"
+ */
+std::string format(time_t t);
+
+/**
+ * @brief Date courante formatée, telle qu'au dernier update()
+ *
+ * Initialisée au premier appel si la boucle ne l'a pas encore fait.
+ */
+const std::string& now();
+
+/**
+ * @brief Reformate la date courante si la seconde a changé
+ */
+void update();
+
+} // namespace HttpDate
+
+#endif // HTTP_DATE_HPP
@@ -2,9 +2,27 @@
 #define HTTP_STRING_UTILS_HPP
 
 #include <string>
+#include <vector>
+#include <sys/types.h>
+
+#define MAX_BYTE_RANGES 32 // Au-delà, l'en-tête Range est ignoré (fichier entier)
 
 namespace HttpStringUtils {
 
+/**
+ * @brief Plage d'octets d'une ressource, bornes incluses
+ */
+struct ByteRange {
+    off_t first;
+    off_t last;
+};
+
+enum RangeResult {
+    RANGE_IGNORED,        // En-tête invalide ou non pris en charge : ressource entière (200)
+    RANGE_SATISFIABLE,    // Au moins une plage à servir (206)
+    RANGE_UNSATISFIABLE   // Aucune plage dans la ressource (416)
+};
+
 /**
  * @brief Normalise un ETag en supprimant les guillemets au début et à la fin
  * @param etag L'ETag à normaliser
@@ -12,6 +30,22 @@ namespace HttpStringUtils {
  */
 std::string normalizeETag(const std::string& etag);
 
+/**
+ * @brief Indique si un codage de contenu est accepté d'après Accept-Encoding
+ * @param accept_encoding Valeur de l'en-tête Accept-Encoding
+ * @param coding Codage recherché, en minuscules ("gzip", "br")
+ * @return true si le codage (ou "*") est listé avec une qualité non nulle
+ */
+bool acceptsEncoding(const std::string& accept_encoding, const char* coding);
+
+/**
+ * @brief Analyse un en-tête Range "bytes=0-499, 1000-, -500" (RFC 9110 §14.1)
+ * @param value Valeur de l'en-tête Range
+ * @param size Taille de la représentation
+ * @param ranges Reçoit les plages satisfaisables, triées et fusionnées si elles se chevauchent (vide sauf RANGE_SATISFIABLE)
+ */
+RangeResult parseRange(const std::string& value, off_t size, std::vector<ByteRange>& ranges);
+
 } // namespace HttpStringUtils
 
 #endif // HTTP_STRING_UTILS_HPP 
\ No newline at end of file
@@ -0,0 +1,56 @@
+#ifndef MIME_TYPES_HPP
+#define MIME_TYPES_HPP
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <cstddef>
+
+#define MIME_MAX_EXTENSION 31 // Extensions plus longues : type par défaut
+
+/**
+ * @brief Table des types MIME par extension
+ *
+ * Les types intégrés sont une table statique ; la configuration (bloc
+ * types {} ou fichier mime.types) peut en ajouter ou en remplacer au
+ * démarrage. La recherche se fait dans une table de hachage à adressage
+ * ouvert : l'extension est mise en minuscules dans un tampon sur la pile
+ * et hachée au passage, le résultat est une référence vers une chaîne de
+ * la table. Aucune allocation par requête.
+ */
+class MimeTypes {
+public:
+    /**
+     * @brief Type MIME d'un fichier d'après son extension (insensible à la casse)
+     * @return Le type, ou "application/octet-stream" si l'extension est inconnue
+     */
+    static const std::string& lookup(const std::string& file_path);
+
+    /**
+     * @brief Ajoute ou remplace le type d'une extension ("md" ou ".md")
+     * @return false si l'extension est vide ou trop longue
+     */
+    static bool add(const std::string& extension, const std::string& type);
+
+    static const std::string& defaultType();
+
+private:
+    struct Slot {
+        char extension[MIME_MAX_EXTENSION + 1]; // En minuscules, sans le point
+        size_t length;                          // 0 : case libre
+        const std::string* type;
+    };
+
+    static std::vector<Slot> slots;           // Taille puissance de 2, remplie au plus à moitié
+    static std::deque<std::string> types;     // Chaînes des types (adresses stables)
+    static size_t used;
+
+    static void initialize();
+    static unsigned long hash(const char* extension, size_t length);
+    static Slot* find(const char* extension, size_t length);
+    static void insert(const char* extension, size_t length, const std::string* type);
+    static void grow();
+    static const std::string* intern(const std::string& type);
+};
+
+#endif // MIME_TYPES_HPP
@@ -0,0 +1,86 @@
+#ifndef OPEN_FILE_CACHE_HPP
+#define OPEN_FILE_CACHE_HPP
+
+#include "http/utils/FileHandle.hpp"
+#include <string>
+#include <list>
+#include <map>
+#include <ctime>
+#include <sys/types.h>
+
+/**
+ * @brief Résultat d'un open() + fstat() sur un chemin
+ */
+struct FileInfo {
+    bool exists;
+    bool is_directory;
+    bool is_regular;
+    bool readable;
+    off_t size;
+    time_t mtime;
+    ino_t inode;
+    std::string last_modified; // mtime au format HTTP, formaté une fois par chargement
+    FileHandle file; // Ouvert pour un fichier régulier lisible
+
+    FileInfo()
+        : exists(false)
+        , is_directory(false)
+        , is_regular(false)
+        , readable(false)
+        , size(0)
+        , mtime(0)
+        , inode(0) {}
+};
+
+/**
+ * @brief Cache LRU des fichiers ouverts et de leurs métadonnées
+ *
+ * Une requête GET interrogeait plusieurs fois le système de fichiers pour
+ * le même chemin (existence, droits, type, ETag, Last-Modified) avant
+ * d'ouvrir le fichier. Le cache garde le fd et le résultat du fstat()
+ * pendant open_file_cache_valid : un fichier souvent demandé ne coûte plus
+ * aucun appel système. Seuls les chemins existants sont retenus, un fichier
+ * créé entre-temps est donc vu aussitôt. Avec une taille de 0 le cache est
+ * désactivé et chaque recherche fait un seul open() + fstat().
+ */
+class OpenFileCache {
+public:
+    OpenFileCache(size_t max_entries, unsigned long valid_ms);
+
+    /**
+     * @brief Métadonnées (et fd) d'un chemin, depuis le cache si l'entrée est encore valide
+     * @return true si le chemin existe
+     */
+    bool lookup(const std::string& path, FileInfo& info);
+
+    void invalidate(const std::string& path); // Après une modification connue (DELETE)
+    void clear();
+
+    size_t size() const { return index.size(); }
+    unsigned long getHits() const { return hits; }
+    unsigned long getMisses() const { return misses; }
+
+private:
+    struct Entry {
+        std::string path;
+        FileInfo info;
+        unsigned long loaded_ms; // Horloge monotone au chargement
+    };
+    typedef std::list<Entry> EntryList;
+
+    size_t max_entries;
+    unsigned long valid_ms;
+    EntryList entries;                             // Du plus récemment utilisé au plus ancien
+    std::map<std::string, EntryList::iterator> index;
+    unsigned long hits;
+    unsigned long misses;
+
+    static void load(const std::string& path, FileInfo& info);
+    static unsigned long nowMs();
+
+    // Non copiable : l'index pointe dans la liste
+    OpenFileCache(const OpenFileCache&);
+    OpenFileCache& operator=(const OpenFileCache&);
+};
+
+#endif // OPEN_FILE_CACHE_HPP
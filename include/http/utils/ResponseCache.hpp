@@ -0,0 +1,97 @@
+#ifndef RESPONSE_CACHE_HPP
+#define RESPONSE_CACHE_HPP
+
+#include "http/utils/SharedBuffer.hpp"
+#include "http/utils/OpenFileCache.hpp"
+#include <string>
+#include <list>
+#include <map>
+#include <vector>
+
+class HttpResponse;
+
+/**
+ * @brief Cache mémoire des réponses complètes des petits fichiers statiques
+ *
+ * Chaque entrée contient la réponse 200 préconstruite (en-têtes dont ETag
+ * et Last-Modified, body), indexée par le chemin résolu de la requête. Un
+ * hit part tel quel dans la file d'envoi derrière la ligne de statut et
+ * Date : ni lecture de fichier ni sérialisation d'en-têtes. Les répertoires des
+ * fichiers en cache sont surveillés par inotify ; une modification,
+ * suppression ou un renommage invalide aussitôt les entrées concernées.
+ * Le cache est borné en nombre d'entrées et en taille de fichier.
+ */
+class ResponseCache {
+public:
+    ResponseCache(size_t max_entries, size_t max_file_size);
+    ~ResponseCache();
+
+    /**
+     * @brief Crée l'instance inotify, dans le processus qui servira les requêtes
+     * @return false si le cache est désactivé ou si inotify est indisponible
+     */
+    bool start();
+    bool enabled() const { return watch_fd >= 0; }
+    int getWatchFd() const { return watch_fd; }
+
+    /**
+     * @brief Réponse préconstruite pour ce chemin résolu
+     * @return true sur un hit (response partage alors le tampon du cache)
+     */
+    bool lookup(const std::string& path, SharedBuffer& response);
+
+    /**
+     * @brief Préconstruit et retient une réponse 200 construite à partir d'un fichier
+     * @param path Chemin résolu de la requête (clé)
+     * @param file_path Fichier servi (surveillé), différent de path pour un index
+     * @param info Métadonnées sur lesquelles la réponse a été construite
+     * @return false si la réponse n'est pas éligible ou si le fichier a changé depuis
+     */
+    bool store(const std::string& path, const std::string& file_path,
+               const FileInfo& info, const HttpResponse& response);
+
+    /**
+     * @brief Lit les événements inotify en attente et invalide les entrées touchées
+     * @param invalidated Reçoit les fichiers servis des entrées retirées
+     */
+    void processEvents(std::vector<std::string>& invalidated);
+
+    /**
+     * @brief Invalide les entrées d'un fichier modifié par le serveur (DELETE)
+     * @param invalidated Reçoit les fichiers servis des entrées retirées
+     */
+    void invalidate(const std::string& file_path, std::vector<std::string>& invalidated);
+    void clear();
+
+    size_t size() const { return index.size(); }
+    unsigned long getHits() const { return hits; }
+    unsigned long getMisses() const { return misses; }
+    double hitRatio() const; // Part des recherches servies depuis le cache (0 à 1)
+
+private:
+    struct Entry {
+        std::string path;       // Clé : chemin résolu de la requête
+        std::string file_path;  // Fichier servi
+        std::string name;       // Nom du fichier d'origine dans son répertoire surveillé
+        int wd;                 // Watch inotify du répertoire
+        SharedBuffer response;
+    };
+    typedef std::list<Entry> EntryList;
+
+    size_t max_entries;
+    size_t max_file_size;
+    int watch_fd;                                  // Instance inotify (-1 si désactivé)
+    EntryList entries;                             // Du plus récemment utilisé au plus ancien
+    std::map<std::string, EntryList::iterator> index;
+    unsigned long hits;
+    unsigned long misses;
+
+    void erase(EntryList::iterator entry, std::vector<std::string>& invalidated);
+    static bool concerns(const Entry& entry, const std::string& name);
+
+    // Non copiable : l'index pointe dans la liste et le fd inotify est possédé
+    ResponseCache(const ResponseCache&);
+    ResponseCache& operator=(const ResponseCache&);
+};
+
+#endif // RESPONSE_CACHE_HPP
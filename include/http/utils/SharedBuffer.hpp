@@ -0,0 +1,36 @@
+#ifndef SHARED_BUFFER_HPP
+#define SHARED_BUFFER_HPP
+
+#include <string>
+#include <cstddef>
+
+/**
+ * @brief Tampon immuable partagé, libéré à la dernière référence
+ *
+ * Une réponse préconstruite du cache part telle quelle dans la file d'envoi
+ * de chaque client qui la demande : copier un SharedBuffer incrémente un
+ * compteur de références, les octets ne sont jamais recopiés. Le tampon
+ * reste valide pour les envois en cours même si le cache l'a abandonné.
+ */
+class SharedBuffer {
+public:
+    SharedBuffer();
+    explicit SharedBuffer(std::string& data); // Prend le contenu de data (swap), data est vidée
+    SharedBuffer(const SharedBuffer& other);
+    SharedBuffer& operator=(const SharedBuffer& other);
+    ~SharedBuffer();
+
+    const char* data() const { return shared ? shared->data.data() : NULL; }
+    size_t size() const { return shared ? shared->data.size() : 0; }
+    bool empty() const { return size() == 0; }
+    void reset(); // Abandonne la référence (libération si c'était la dernière)
+
+private:
+    struct Shared {
+        std::string data;
+        int refs;
+    };
+    Shared* shared;
+};
+
+#endif // SHARED_BUFFER_HPP
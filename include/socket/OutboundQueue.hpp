@@ -0,0 +1,112 @@
+#ifndef OUTBOUND_QUEUE_HPP
+# define OUTBOUND_QUEUE_HPP
+
+# include <string>
+# include <deque>
+# include <sys/types.h>
+# include "http/utils/FileHandle.hpp"
+# include "http/utils/SharedBuffer.hpp"
+
+# define MAX_FLUSH_IOVECS 64 // Nombre max de segments envoyés par appel système
+# define SENDFILE_SLICE (1024 * 1024) // Octets de fichier envoyés par appel à sendfile()
+
+/**
+ * @brief File des données à envoyer sur une connexion
+ *
+ * Les réponses sont ajoutées dans l'ordre puis envoyées au fil des
+ * disponibilités du socket : un envoi partiel est repris au prochain
+ * POLLOUT/EPOLLOUT, là où il s'était arrêté.
+ *
+ * Chaque réponse garde ses en-têtes et son body dans deux tampons distincts,
+ * envoyés ensemble par un seul appel vectorisé (sendmsg, équivalent de
+ * writev) : le body n'est jamais recopié derrière les en-têtes. Plusieurs
+ * réponses pipelinées partent dans le même appel. Un body fichier est
+ * envoyé après les en-têtes par sendfile(), sans passer en mémoire.
+ */
+class OutboundQueue {
+public:
+    enum FlushResult {
+        FLUSH_DONE,    // Tout a été envoyé
+        FLUSH_AGAIN,   // Socket plein : attendre qu'il redevienne inscriptible
+        FLUSH_ERROR    // Erreur d'envoi ou connexion fermée par le client
+    };
+
+    OutboundQueue();
+
+    /**
+     * @brief Ajoute des données en fin de file
+     * @param data Données à envoyer ; leur contenu est transféré (swap), data est vidée
+     */
+    void enqueue(std::string& data);
+
+
+    /**
+     * @brief Tampon où sérialiser les en-têtes de la prochaine réponse
+     *
+     * Sa capacité est recyclée d'une réponse à l'autre : en régime établi,
+     * la sérialisation des en-têtes n'alloue pas.
+     */
+    std::string& headerBuffer();
+
+    /**
+     * @brief Ajoute une réponse : les en-têtes écrits dans headerBuffer() et le body
+     * @param body Body de la réponse ; son contenu est transféré (swap), body est vidé
+     */
+    void enqueueResponse(std::string& body);
+
+    /**
+     * @brief Ajoute une réponse : ce qui est écrit dans headerBuffer(), puis un
+     *        tampon partagé (réponse du cache, page d'erreur préchargée), sans copie
+     */
+    void enqueueResponse(const SharedBuffer& data);
+
+    /**
+     * @brief Ajoute une réponse dont le body est une portion de fichier
+     */
+    void enqueueResponse(const FileHandle& file, off_t offset, size_t length);
+
+    /**
+     * @brief Termine la réponse en cours : ses éléments (en-têtes, parties d'un
+     *        multipart...) comptent pour une seule réponse dans responses()
+     */
+    void endResponse();
+
+    /**
+     * @brief Envoie autant de données que le socket en accepte sans bloquer
+     */
+    FlushResult flush(int fd);
+
+    void clear();
+    bool empty() const { return chunks.empty(); }
+    size_t size() const { return chunks.size(); } // Nombre d'éléments en attente (plusieurs par réponse possible)
+    size_t responses() const { return response_count; } // Réponses complètes en attente (100 Continue exclu)
+    size_t pendingBytes() const { return pending; }
+
+private:
+    struct Chunk {
+        std::string head;   // En-têtes (ou données brutes)
+        std::string body;
+        SharedBuffer shared; // Réponse préconstruite, envoyée après head et body
+        FileHandle file;    // Body fichier, envoyé après les données en mémoire
+        off_t file_offset;  // Prochain octet du fichier à envoyer
+        size_t file_left;   // Octets du fichier restant à envoyer
+        bool ends_response; // Dernier élément d'une réponse
+
+        Chunk() : file_offset(0), file_left(0), ends_response(false) {}
+        size_t memorySize() const { return head.size() + body.size() + shared.size(); }
+    };
+
+    std::deque<Chunk> chunks;        // Données en attente, dans l'ordre d'envoi
+    size_t offset;                   // Octets déjà envoyés du premier élément (en-têtes puis body)
+    size_t pending;                  // Total des octets restant à envoyer
+    size_t response_count;           // Réponses dont le dernier élément n'est pas encore parti
+    std::string header_buffer;       // En-têtes de la réponse en cours de construction
+    std::string spare_header;        // Capacité récupérée sur une réponse envoyée
+
+    Chunk& pushChunk();
+    void popFront();
+    FlushResult sendMemory(int fd);
+    FlushResult sendFile(int fd);
+};
+
+#endif
@@ -29,6 +29,7 @@ public:
     // Configuration
     void setNonBlocking(bool non_blocking);
     void setReuseAddr(bool reuse);
+    void setReusePort(bool reuse);
 
     // Opérations d'E/S
     ssize_t send(const std::string& data);
@@ -0,0 +1,192 @@
+#include "Connection.hpp"
+#include "Server.hpp"
+
+/**
+ * @brief Constructeur par défaut (slot vide)
+ */
+Connection::Connection()
+    : fd(-1)
+    , server(NULL)
+    , read_state(READ_HEADERS)
+    , max_body_size(HttpRequest::DEFAULT_MAX_BODY_SIZE)
+    , expect_continue(false)
+    , close_after_write(false)
+    , lingering_close(false)
+    , timer_phase(TIMER_NONE)
+    , requests_served(0) {
+}
+
+/**
+ * @brief Attribue le slot à un client nouvellement accepté
+ */
+void Connection::open(int client_fd, Server* owner) {
+    fd = client_fd;
+    server = owner;
+    resetRequest();
+    outbound.clear();
+    close_after_write = false;
+    lingering_close = false;
+    timer_phase = TIMER_NONE;
+    requests_served = 0;
+}
+
+/**
+ * @brief Libère le slot
+ * 
+ * Le tampon de lecture garde sa capacité pour éviter une allocation au
+ * prochain accept sur ce fd, sauf s'il a grossi pour un gros body.
+ */
+void Connection::release() {
+    fd = -1;
+    server = NULL;
+    resetRequest();
+    if (read_buffer.capacity() > MAX_IDLE_BUFFER_SIZE) {
+        std::string().swap(read_buffer);
+    }
+    if (body.capacity() > MAX_IDLE_BUFFER_SIZE) {
+        std::string().swap(body);
+    }
+    outbound.clear();
+}
+
+/**
+ * @brief Fait avancer la machine à états avec les octets déjà reçus
+ * 
+ * Le parser reprend là où il s'était arrêté au réveil précédent : les
+ * octets déjà analysés ne sont jamais relus.
+ * @return true si la requête est complète
+ */
+bool Connection::advance() {
+    if (read_state == READ_COMPLETE || read_state == READ_ERROR) {
+        return read_state == READ_COMPLETE;
+    }
+
+    bool headers_done = parser.headersComplete();
+    parser.feed(read_buffer.data(), read_buffer.size());
+    if (!headers_done && parser.headersComplete()) {
+        startBody();
+    }
+    if (parser.getState() == RequestParser::STATE_BODY && parser.isChunked()) {
+        decodeChunkedBody();
+    }
+
+    switch (parser.getState()) {
+        case RequestParser::STATE_COMPLETE:
+            read_state = READ_COMPLETE;
+            break;
+        case RequestParser::STATE_ERROR:
+            read_state = READ_ERROR;
+            break;
+        case RequestParser::STATE_BODY:
+            read_state = READ_BODY;
+            break;
+        default:
+            read_state = READ_HEADERS;
+            break;
+    }
+    return read_state == READ_COMPLETE;
+}
+
+/**
+ * @brief Fin des en-têtes : la limite du body de la location est désormais connue
+ * 
+ * Un Content-Length supérieur à la limite est refusé (413) sans attendre le
+ * body : la mémoire utilisée reste bornée par la limite.
+ */
+void Connection::startBody() {
+    max_body_size = HttpRequest::DEFAULT_MAX_BODY_SIZE;
+    if (server) {
+        max_body_size = server->getMaxBodySize(parser.getTarget().str(read_buffer.data()));
+    }
+    decoder.setMaxBodySize(max_body_size);
+
+    // Body annoncé trop grand : refusé dès les en-têtes, avant d'en recevoir le moindre octet
+    if (parser.hasContentLength() && parser.getContentLength() > max_body_size) {
+        parser.setError(413);
+        return;
+    }
+
+    // Expect n'a de sens qu'en HTTP/1.1 et pour une requête avec body (RFC 9110 §10.1.1)
+    const char* data = read_buffer.data();
+    const HeaderSpan* expect = parser.findHeader(data, "expect");
+    if (expect && RequestParser::equalsIgnoreCase(data, parser.getVersion(), "http/1.1")) {
+        if (!RequestParser::equalsIgnoreCase(data, expect->value, "100-continue")) {
+            parser.setError(417);
+        } else if (parser.getState() == RequestParser::STATE_BODY) {
+            expect_continue = true;
+        }
+    }
+}
+
+/**
+ * @brief Refuse la requête en cours avant la fin de sa réception
+ */
+void Connection::rejectRequest(int code) {
+    parser.setError(code);
+    read_state = READ_ERROR;
+    expect_continue = false;
+}
+
+/**
+ * @brief Le body de la requête en cours a-t-il commencé à arriver ?
+ */
+bool Connection::bodyStarted() const {
+    return read_buffer.size() > parser.getHeadersEnd() || decoder.getDecodedSize() > 0;
+}
+
+/**
+ * @brief Décode les octets chunked reçus depuis le dernier réveil
+ * 
+ * Les octets encodés sont retirés du tampon dès qu'ils sont décodés : la
+ * mémoire ne contient jamais le flux encodé en entier, et une requête
+ * pipelinée qui suit reste en tête du tampon une fois le body terminé.
+ */
+void Connection::decodeChunkedBody() {
+    size_t start = parser.getHeadersEnd();
+    size_t consumed = 0;
+    ChunkedDecoder::Result result = decoder.decode(read_buffer.data() + start,
+                                                   read_buffer.size() - start, consumed, body);
+    read_buffer.erase(start, consumed);
+
+    if (result == ChunkedDecoder::DECODE_DONE) {
+        parser.completeBody();
+    } else if (result == ChunkedDecoder::DECODE_ERROR) {
+        parser.setError(decoder.getErrorCode());
+    }
+}
+
+/**
+ * @brief Retire la requête traitée du tampon et analyse la suivante
+ * 
+ * Seuls les octets de la requête sont consommés : ceux d'une requête
+ * pipelinée arrivés dans le même recv() restent dans le tampon.
+ */
+void Connection::consumeRequest() {
+    size_t consumed = parser.getRequestSize();
+    if (consumed >= read_buffer.size()) {
+        read_buffer.clear();
+    } else {
+        read_buffer.erase(0, consumed);
+    }
+
+    read_state = READ_HEADERS;
+    parser.reset();
+    decoder.reset();
+    body.clear();
+    expect_continue = false;
+    if (!read_buffer.empty()) {
+        advance();
+    }
+}
+
+/**
+ * @brief Abandonne tout le contenu du tampon de lecture
+ */
+void Connection::resetRequest() {
+    read_state = READ_HEADERS;
+    read_buffer.clear();
+    parser.reset();
+    decoder.reset();
+    body.clear();
+    expect_continue = false;
+}
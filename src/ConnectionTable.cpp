@@ -0,0 +1,51 @@
+#include "ConnectionTable.hpp"
+#include <sys/resource.h>
+
+/**
+ * @brief Constructeur : la limite suit RLIMIT_NOFILE
+ */
+ConnectionTable::ConnectionTable()
+    : max_slots(DEFAULT_MAX_SLOTS)
+    , active(0) {
+    struct rlimit rl;
+    if (getrlimit(RLIMIT_NOFILE, &rl) == 0 && rl.rlim_cur != RLIM_INFINITY) {
+        max_slots = static_cast<size_t>(rl.rlim_cur);
+    }
+    slots.resize(max_slots < INITIAL_SLOTS ? max_slots : INITIAL_SLOTS);
+}
+
+/**
+ * @brief Attribue le slot d'un fd nouvellement accepté
+ */
+Connection* ConnectionTable::open(int fd, Server* server) {
+    if (fd < 0 || static_cast<size_t>(fd) >= max_slots) {
+        return NULL;
+    }
+
+    if (static_cast<size_t>(fd) >= slots.size()) {
+        // Croissance par doublement, bornée par la limite de descripteurs
+        size_t new_size = slots.size() > 0 ? slots.size() : INITIAL_SLOTS;
+        while (new_size <= static_cast<size_t>(fd)) {
+            new_size *= 2;
+        }
+        slots.resize(new_size < max_slots ? new_size : max_slots);
+    }
+
+    Connection& conn = slots[fd];
+    if (!conn.isOpen()) {
+        active++;
+    }
+    conn.open(fd, server);
+    return &conn;
+}
+
+/**
+ * @brief Libère le slot d'un fd
+ */
+void ConnectionTable::release(int fd) {
+    Connection* conn = get(fd);
+    if (conn) {
+        conn->release();
+        active--;
+    }
+}
@@ -0,0 +1,213 @@
+#include "MasterProcess.hpp"
+#include "MultiServerManager.hpp"
+#include <sys/wait.h>
+#include <ctime>
+
+volatile sig_atomic_t MasterProcess::stop_requested = 0;
+volatile sig_atomic_t MasterProcess::reload_requested = 0;
+
+/**
+ * @brief Constructeur du processus maître
+ */
+MasterProcess::MasterProcess(const WebservConfig& config)
+    : config(config) {
+}
+
+/**
+ * @brief Destructeur du processus maître
+ */
+MasterProcess::~MasterProcess() {
+}
+
+/**
+ * @brief Gestionnaire de signal du maître : demande l'arrêt de la supervision,
+ *        ou le rechargement des workers (SIGHUP)
+ */
+void MasterProcess::signalHandler(int signal) {
+    if (signal == SIGHUP) {
+        reload_requested = 1;
+        return;
+    }
+    stop_requested = 1;
+}
+
+/**
+ * @brief Configure les gestionnaires de signaux du maître
+ */
+void MasterProcess::setupSignalHandlers() {
+    struct sigaction sa;
+    sa.sa_handler = signalHandler;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags = 0; // Pas de SA_RESTART : waitpid() doit être interrompu
+    
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    sigaction(SIGHUP, &sa, NULL);
+}
+
+/**
+ * @brief Détermine le nombre de workers à lancer
+ * @param configured Valeur de worker_processes (0 = auto)
+ */
+int MasterProcess::resolveWorkerCount(int configured) {
+    if (configured > 0) {
+        return configured;
+    }
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    return cores > 0 ? static_cast<int>(cores) : 1;
+}
+
+/**
+ * @brief Retrouve le slot d'un worker à partir de son PID
+ */
+int MasterProcess::findSlot(pid_t pid) const {
+    for (size_t i = 0; i < workers.size(); i++) {
+        if (workers[i] == pid) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Corps d'un worker : sa propre instance de MultiServerManager
+ */
+int MasterProcess::runWorker(size_t slot) {
+    // Restaurer le comportement par défaut avant que le manager installe ses handlers
+    signal(SIGINT, SIG_DFL);
+    signal(SIGTERM, SIG_DFL);
+    signal(SIGHUP, SIG_IGN); // Jusqu'à ce que le manager installe le sien : un rechargement ne tue pas le worker
+    
+    LOG_INFO("Worker #" << slot << " started (pid " << getpid() << ")");
+    
+    MultiServerManager server_manager;
+    try {
+        server_manager.initServers(config);
+        server_manager.startServers();
+    } catch (const std::exception& e) {
+        LOG_ERROR("Worker #" << slot << " error: " << e.what());
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Fork un worker pour le slot donné
+ * @return Le PID du worker, ou -1 si fork() a échoué
+ */
+pid_t MasterProcess::spawnWorker(size_t slot) {
+    pid_t pid = fork();
+    if (pid < 0) {
+        LOG_ERROR("Failed to fork worker #" << slot << ": " << strerror(errno));
+        return -1;
+    }
+    
+    if (pid == 0) {
+        // Le worker ne revient jamais dans la boucle de supervision
+        exit(runWorker(slot));
+    }
+    
+    workers[slot] = pid;
+    spawn_times[slot] = time(NULL);
+    return pid;
+}
+
+/**
+ * @brief Transmet un signal à tous les workers vivants
+ */
+void MasterProcess::signalWorkers(int signal) {
+    for (size_t i = 0; i < workers.size(); i++) {
+        if (workers[i] > 0) {
+            kill(workers[i], signal);
+        }
+    }
+}
+
+/**
+ * @brief Arrête tous les workers et attend leur terminaison
+ */
+void MasterProcess::stopWorkers() {
+    signalWorkers(SIGTERM);
+    
+    for (size_t i = 0; i < workers.size(); i++) {
+        if (workers[i] > 0) {
+            while (waitpid(workers[i], NULL, 0) < 0 && errno == EINTR) {
+            }
+            workers[i] = -1;
+        }
+    }
+}
+
+/**
+ * @brief Lance les workers puis les supervise jusqu'à SIGINT/SIGTERM
+ * @return Le code de sortie du processus maître
+ */
+int MasterProcess::run() {
+    int count = resolveWorkerCount(config.worker_processes);
+    workers.assign(count, -1);
+    spawn_times.assign(count, 0);
+    
+    setupSignalHandlers();
+    
+    for (int i = 0; i < count; i++) {
+        if (spawnWorker(i) < 0) {
+            stopWorkers();
+            return 1;
+        }
+    }
+    LOG_SUCCESS("Master process " << getpid() << " started " << count << " worker(s)");
+    
+    int alive = count;
+    while (!stop_requested && alive > 0) {
+        int status = 0;
+        pid_t pid = waitpid(-1, &status, 0);
+        if (reload_requested) {
+            reload_requested = 0;
+            LOG_INFO("Master process reloading workers");
+            signalWorkers(SIGHUP);
+        }
+        if (pid < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            LOG_ERROR("waitpid failed: " << strerror(errno));
+            break;
+        }
+        
+        int slot = findSlot(pid);
+        if (slot < 0) {
+            continue; // Pas un worker (ne devrait pas arriver)
+        }
+        workers[slot] = -1;
+        
+        if (stop_requested) {
+            break;
+        }
+        
+        // Un worker qui sort avec le code 1 a échoué à s'initialiser (bind...) : inutile de le relancer
+        if (WIFEXITED(status) && WEXITSTATUS(status) == 1) {
+            LOG_ERROR("Worker #" << slot << " (pid " << pid << ") failed to start, not respawning");
+            alive--;
+            continue;
+        }
+        
+        if (WIFSIGNALED(status)) {
+            LOG_WARNING("Worker #" << slot << " (pid " << pid << ") killed by signal " << WTERMSIG(status) << ", respawning");
+        } else {
+            LOG_WARNING("Worker #" << slot << " (pid " << pid << ") exited, respawning");
+        }
+        
+        // Éviter une boucle de relance si le worker meurt immédiatement
+        if (time(NULL) - spawn_times[slot] < WORKER_RESPAWN_DELAY) {
+            sleep(WORKER_RESPAWN_DELAY);
+        }
+        if (spawnWorker(slot) < 0) {
+            alive--;
+        }
+    }
+    
+    LOG_INFO("Master process stopping workers...");
+    stopWorkers();
+    LOG_SUCCESS("All workers stopped");
+    return alive > 0 ? 0 : 1;
+}
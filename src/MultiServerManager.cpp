@@ -1,6 +1,11 @@
 #include "MultiServerManager.hpp"
+#include "http/utils/HttpDate.hpp"
+#include "http/utils/MimeTypes.hpp"
 #include <csignal>
 #include <cstring>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
 #include <vector>
 
 // Initialisation de la variable statique
@@ -10,15 +15,13 @@ MultiServerManager* MultiServerManager::instance = NULL;
  * @brief Constructeur de la classe MultiServerManager
  */
 MultiServerManager::MultiServerManager() 
-    : poll_fds(NULL)
-    , nfds(0)
-    , running(false) {
+    : poller(NULL)
+    , reuse_port(false)
+    , reserve_fd(-1)
+    , running(false)
+    , reload_requested(0) {
     // Enregistrer l'instance pour le gestionnaire de signal
     instance = this;
-    
-    // Allouer de la mémoire pour le tableau poll
-    poll_fds = new struct pollfd[MAX_POLL_SIZE];
-    memset(poll_fds, 0, sizeof(struct pollfd) * MAX_POLL_SIZE);
 }
 
 /**
@@ -40,12 +43,16 @@ MultiServerManager::~MultiServerManager() {
     }
     
     port_to_server_index.clear();
-    fd_to_server.clear();
     
-    // Libérer la mémoire du tableau poll
-    if (poll_fds) {
-        delete[] poll_fds;
-        poll_fds = NULL;
+    if (reserve_fd >= 0) {
+        close(reserve_fd);
+        reserve_fd = -1;
+    }
+    
+    // Libérer le backend d'événements
+    if (poller) {
+        delete poller;
+        poller = NULL;
     }
     
     // Ne pas mettre instance à NULL ici car cela pourrait causer des problèmes
@@ -63,13 +70,21 @@ void MultiServerManager::setupSignalHandlers() {
     
     sigaction(SIGINT, &sa, NULL);  // Ctrl+C
     sigaction(SIGTERM, &sa, NULL); // Signal de terminaison
+    sigaction(SIGHUP, &sa, NULL);  // Rechargement des pages d'erreur
+    
+    // Un client qui ferme sa connexion pendant un envoi ne doit pas tuer le serveur
+    signal(SIGPIPE, SIG_IGN);
 }
 
 /**
  * @brief Gestionnaire statique des signaux
  */
 void MultiServerManager::signalHandler(int signal) {
-    (void)signal; // Marquer le paramètre comme utilisé pour éviter l'avertissement
+    if (instance && signal == SIGHUP) {
+        // Le rechargement lit des fichiers : il est fait par la boucle principale
+        instance->reload_requested = 1;
+        return;
+    }
     if (instance) {
         // Plutôt que d'appeler stopServers() qui pourrait causer des problèmes dans un handler de signal,
         // on arrête simplement la boucle principale pour permettre une sortie propre
@@ -104,6 +119,15 @@ void MultiServerManager::initServers(const WebservConfig& config) {
         throw std::runtime_error("No valid server configured");
     }
     
+    event_backend = config.event_backend;
+    reuse_port = (config.worker_processes != 1);
+
+    // Types MIME ajoutés par la configuration (bloc types, fichier mime_types)
+    for (std::map<std::string, std::string>::const_iterator it = config.mime_types.begin();
+         it != config.mime_types.end(); ++it) {
+        MimeTypes::add(it->first, it->second);
+    }
+    
     LOG_SUCCESS("Initialized " << servers.size() << " server(s) successfully");
     
     // Configuration des gestionnaires de signaux
@@ -111,98 +135,195 @@ void MultiServerManager::initServers(const WebservConfig& config) {
 }
 
 /**
- * @brief Ajoute un descripteur de fichier au tableau poll
+ * @brief Ajoute un descripteur de fichier à la boucle d'événements
+ * @return false si le descripteur n'a pas pu être ajouté (l'appelant le ferme)
  */
-void MultiServerManager::addFdToPoll(int fd, Server* server) {
-    if (nfds >= MAX_POLL_SIZE) {
+bool MultiServerManager::addFdToPoll(int fd, Server* server) {
+    if (poller->size() >= MAX_POLL_SIZE) {
         LOG_WARNING("Maximum poll size reached, cannot add more descriptors");
-        return;
+        return false;
     }
     
-    poll_fds[nfds].fd = fd;
-    poll_fds[nfds].events = POLLIN;
-    poll_fds[nfds].revents = 0;
-    
-    fd_to_server[fd] = server;
-    nfds++;
+    return poller->add(fd, Poller::EVENT_READ, server);
+}
+
+/**
+ * @brief Retire un descripteur de fichier de la boucle d'événements
+ */
+void MultiServerManager::removeFdFromPoll(int fd) {
+    poller->remove(fd);
 }
 
 /**
- * @brief Supprime un descripteur de fichier du tableau poll
+ * @brief Gère un événement prêt
  */
-void MultiServerManager::removeFdFromPoll(int fd_index) {
-    if (fd_index < 0 || fd_index >= nfds) {
+void MultiServerManager::handleEvent(const PollEvent& event) {
+    int fd = event.fd;
+    
+    // Socket client : un seul accès indexé dans la table des connexions
+    Connection* conn = connections.get(fd);
+    if (conn) {
+        handleClientEvent(*conn, event.events);
+        return;
+    }
+    
+    // Sinon, c'est un socket d'écoute ou la surveillance inotify d'un serveur
+    Server* server = static_cast<Server*>(event.data);
+    if (fd == server->getWatchFd()) {
+        server->handleFileEvents();
+        return;
+    }
+    if (event.events & Poller::EVENT_ERROR) {
+        // Erreur critique sur socket serveur
+        LOG_ERROR("Error on server socket for port " << server->getPort());
+        running = false;
         return;
     }
     
-    int fd = poll_fds[fd_index].fd;
-    fd_to_server.erase(fd);
+    acceptConnections(server);
+}
+
+/**
+ * @brief Accepte les connexions en attente sur un socket d'écoute
+ * 
+ * Le nombre d'accept() par réveil suit la file d'attente : il double quand
+ * le budget est épuisé et diminue quand la file se vide vite. Au-delà de la
+ * capacité (MAX_POLL_SIZE, RLIMIT_NOFILE), la connexion reçoit un 503 et
+ * est fermée aussitôt au lieu de fuir.
+ */
+void MultiServerManager::acceptConnections(Server* server) {
+    int budget = server->getAcceptBudget();
+    int accepted = 0;
+    bool drained = false;
     
-    // Compacter le tableau en déplaçant le dernier fd à cette position
-    if (fd_index < nfds - 1) {
-        poll_fds[fd_index] = poll_fds[nfds - 1];
+    while (accepted < budget) {
+        int client_fd = server->acceptNewConnection();
+        if (client_fd < 0) {
+            if (errno == EMFILE || errno == ENFILE) {
+                // Plus de descripteur : libérer la réserve pour refuser proprement
+                // la connexion, sinon elle resterait dans la file et poll() bouclerait
+                rejectWithReserveFd(server);
+                break;
+            }
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                LOG_ERROR("Error accepting connection: " << strerror(errno));
+            }
+            drained = true;
+            break; // Plus de connexions à accepter pour le moment
+        }
+        accepted++;
+        
+        Connection* client = NULL;
+        if (poller->size() < MAX_POLL_SIZE) {
+            client = connections.open(client_fd, server);
+        }
+        if (!client) {
+            LOG_WARNING("Server at capacity, rejecting fd " << client_fd);
+            server->rejectConnection(client_fd);
+            continue;
+        }
+        
+        // Ajouter le nouveau client à la boucle d'événements
+        if (!addFdToPoll(client_fd, server)) {
+            connections.release(client_fd);
+            server->rejectConnection(client_fd);
+            continue;
+        }
+        server->updateClientTimer(*client, timers);
     }
     
-    nfds--;
+    server->adjustAcceptBudget(accepted, drained);
 }
 
 /**
- * @brief Récupère le serveur associé à un fd
+ * @brief Refuse une connexion quand le processus n'a plus de descripteur libre
  */
-Server* MultiServerManager::getServerByFd(int fd) const {
-    std::map<int, Server*>::const_iterator it = fd_to_server.find(fd);
-    if (it != fd_to_server.end()) {
-        return it->second;
+void MultiServerManager::rejectWithReserveFd(Server* server) {
+    if (reserve_fd >= 0) {
+        close(reserve_fd);
+        reserve_fd = -1;
     }
-    return NULL;
+    
+    int client_fd = server->acceptNewConnection();
+    if (client_fd >= 0) {
+        LOG_WARNING("Out of file descriptors, rejecting fd " << client_fd);
+        server->rejectConnection(client_fd);
+    }
+    
+    reserve_fd = open("/dev/null", O_RDONLY | O_CLOEXEC);
 }
 
 /**
- * @brief Gère un événement de poll
+ * @brief Gère un événement sur un socket client
  */
-bool MultiServerManager::handleEvent(int index) {
-    int fd = poll_fds[index].fd;
-    Server* server = getServerByFd(fd);
+void MultiServerManager::handleClientEvent(Connection& conn, int events) {
+    Server* server = conn.server;
     
-    if (!server) {
-        LOG_ERROR("No server associated with fd: " << fd);
-        removeFdFromPoll(index);
-        return false;
+    // D'abord vider la file de sortie, puis lire
+    bool keep_connection = true;
+    if (events & Poller::EVENT_WRITE) {
+        keep_connection = server->handleClientWrite(conn);
+    }
+    if (keep_connection && (events & Poller::EVENT_READ)) {
+        keep_connection = server->handleClientData(conn);
+    } else if (keep_connection && (events & Poller::EVENT_ERROR)) {
+        // Socket client en erreur
+        keep_connection = false;
     }
     
-    // Vérifier si c'est un socket serveur ou client
-    if (server->matchesSocketFd(fd)) {
-        // C'est un socket serveur, accepter plusieurs connexions d'un coup
-        int max_accepts = 10; // Limiter pour éviter la famine des autres événements
-        int accepted = 0;
-        
-        while (accepted < max_accepts) {
-            int client_fd = server->acceptNewConnection();
-            if (client_fd < 0) {
-                if (errno != EAGAIN && errno != EWOULDBLOCK) {
-                    LOG_ERROR("Error accepting connection: " << strerror(errno));
-                }
-                break; // Plus de connexions à accepter pour le moment
-            }
-            
-            // Ajouter le nouveau client au poll
-            addFdToPoll(client_fd, server);
-            accepted++;
+    if (!keep_connection) {
+        // Fermer la connexion si nécessaire
+        closeClient(conn);
+        return;
+    }
+    
+    updateClient(conn);
+}
+
+/**
+ * @brief Met à jour les événements surveillés et le timer d'un client
+ */
+void MultiServerManager::updateClient(Connection& conn) {
+    // Surveiller POLLOUT seulement tant qu'une réponse est en attente
+    int wanted = conn.server->getClientEvents(conn);
+    if (wanted != poller->getEvents(conn.fd)) {
+        poller->modify(conn.fd, wanted, conn.server);
+    }
+    conn.server->updateClientTimer(conn, timers);
+}
+
+/**
+ * @brief Retire un client de la boucle d'événements, ferme sa connexion et libère son slot
+ */
+void MultiServerManager::closeClient(Connection& conn) {
+    int fd = conn.fd;
+    timers.cancel(fd);
+    removeFdFromPoll(fd);
+    conn.server->closeClientConnection(conn);
+    connections.release(fd);
+}
+
+/**
+ * @brief Traite les clients dont le timer a expiré
+ */
+void MultiServerManager::handleTimeouts() {
+    timers.advance(expired_fds);
+    
+    for (size_t i = 0; i < expired_fds.size(); i++) {
+        Connection* conn = connections.get(expired_fds[i]);
+        if (!conn) {
+            continue;
         }
         
-        return true;
-    } else {
-        // C'est un socket client, traiter les données
-        bool keep_connection = server->handleClientData(fd);
-        if (!keep_connection) {
-            // Fermer la connexion si nécessaire
-            server->closeClientConnection(fd);
-            removeFdFromPoll(index);
-            return false;
+        if (conn->server->handleClientTimeout(*conn)) {
+            updateClient(*conn); // 408 en cours d'envoi, borné par send_timeout
+        } else {
+            closeClient(*conn);
         }
     }
-    
-    return true;
 }
 
 /**
@@ -213,27 +334,48 @@ void MultiServerManager::startServers() {
         throw std::runtime_error("No servers initialized");
     }
     
-    // Initialiser tous les serveurs et ajouter leurs sockets au poll
+    // Créer le backend d'événements (epoll si disponible, poll sinon)
+    if (!poller) {
+        poller = Poller::create(event_backend);
+        LOG_INFO("Event backend: " << poller->name());
+    }
+    
+    // Descripteur de réserve, libéré en cas d'EMFILE pour pouvoir refuser une connexion
+    if (reserve_fd < 0) {
+        reserve_fd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+    }
+    
+    // Initialiser tous les serveurs et ajouter leurs sockets à la boucle d'événements
     for (size_t i = 0; i < servers.size(); i++) {
         try {
-            servers[i]->initialize();
+            servers[i]->initialize(reuse_port);
             int server_fd = servers[i]->getSocketFd();
-            addFdToPoll(server_fd, servers[i]);
+            if (!addFdToPoll(server_fd, servers[i])) {
+                throw std::runtime_error("cannot register listening socket");
+            }
+            int watch_fd = servers[i]->getWatchFd();
+            if (watch_fd >= 0 && !addFdToPoll(watch_fd, servers[i])) {
+                throw std::runtime_error("cannot register response cache file watch");
+            }
             LOG_SUCCESS("Server listening on " << BLUE << BOLD << "http://localhost:" << servers[i]->getPort() << RESET);
         } catch (const std::exception& e) {
             LOG_ERROR("Failed to initialize server on port " << servers[i]->getPort() << ": " << e.what());
         }
     }
     
-    if (nfds == 0) {
+    if (poller->size() == 0) {
         throw std::runtime_error("No valid server sockets to listen on");
     }
     
     running = true;
     
-    // Boucle principale
+    // Boucle principale : l'attente est bornée par la prochaine échéance de la roue de timers
     while (running) {
-        int ret = poll(poll_fds, nfds, -1);
+        int ret = poller->wait(ready_events, timers.nextTimeout());
+        HttpDate::update(); // En-tête Date des réponses de ce tour
+        if (reload_requested) {
+            reloadErrorPages();
+        }
         if (ret < 0) {
             if (errno == EINTR) {
                 // Interruption par un signal
@@ -243,35 +385,26 @@ void MultiServerManager::startServers() {
             break;
         }
         
-        // Traitement des événements
-        for (int i = 0; i < nfds; i++) {
-            if (poll_fds[i].revents == 0) {
+        // Traitement des seuls descripteurs prêts
+        for (size_t i = 0; i < ready_events.size() && running; i++) {
+            // Le fd a pu être fermé par le traitement d'un événement précédent
+            if (poller->getData(ready_events[i].fd) != ready_events[i].data) {
                 continue;
             }
-            
-            if (poll_fds[i].revents & POLLIN) {
-                if (handleEvent(i) == false) {
-                    i--; // Ajuster l'index si un fd a été supprimé
-                }
-            }
-            
-            if (poll_fds[i].revents & (POLLERR | POLLHUP | POLLNVAL)) {
-                int fd = poll_fds[i].fd;
-                Server* server = getServerByFd(fd);
-                
-                if (server && !server->matchesSocketFd(fd)) {
-                    // Socket client en erreur
-                    server->closeClientConnection(fd);
-                    removeFdFromPoll(i);
-                    i--;
-                } else if (server && server->matchesSocketFd(fd)) {
-                    // Erreur critique sur socket serveur
-                    LOG_ERROR("Error on server socket for port " << server->getPort());
-                    running = false;
-                    break;
-                }
-            }
+            handleEvent(ready_events[i]);
         }
+        
+        handleTimeouts();
+    }
+}
+
+/**
+ * @brief Relit les pages d'erreur de chaque serveur après un SIGHUP
+ */
+void MultiServerManager::reloadErrorPages() {
+    reload_requested = 0;
+    for (size_t i = 0; i < servers.size(); i++) {
+        servers[i]->reloadErrorPages();
     }
 }
 
@@ -286,14 +419,17 @@ void MultiServerManager::stopServers() {
         
         running = false;
         
-        // Fermer toutes les connexions clients
-        if (poll_fds && nfds > 0) {
-            for (int i = 0; i < nfds; i++) {
-                if (poll_fds[i].fd >= 0) {
-                    Server* server = getServerByFd(poll_fds[i].fd);
-                    if (server && !server->matchesSocketFd(poll_fds[i].fd)) {
-                        server->closeClientConnection(poll_fds[i].fd);
-                    }
+        // Fermer toutes les connexions clients, puis retirer les sockets d'écoute
+        if (poller) {
+            for (int fd = 0; fd <= connections.maxFd(); fd++) {
+                Connection* conn = connections.get(fd);
+                if (conn) {
+                    closeClient(*conn);
+                }
+            }
+            for (int fd = 0; fd <= poller->maxFd(); fd++) {
+                if (poller->isRegistered(fd)) {
+                    removeFdFromPoll(fd);
                 }
             }
         }
@@ -305,10 +441,6 @@ void MultiServerManager::stopServers() {
             }
         }
         
-        // Vider les structures de données
-        fd_to_server.clear();
-        nfds = 0;
-        
         LOG_SUCCESS("Tous les serveurs ont été arrêtés");
     }
 }
@@ -319,7 +451,7 @@ void MultiServerManager::initializeServers() {
         LOG_INFO("Server at port " << port);
         
         try {
-            servers[i]->initialize();
+            servers[i]->initialize(reuse_port);
             LOG_INFO("Listening on port " << port);
         } catch (const std::exception& e) {
             LOG_ERROR("Failed to initialize server on port " << port << ": " << e.what());
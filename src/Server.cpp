@@ -3,11 +3,11 @@
 #include "http/HttpRequest.hpp"
 #include "http/HttpResponse.hpp"
 #include "utils/Common.hpp"
+#include "event/Poller.hpp"
 #include <cstring>
 #include <fcntl.h>
 #include <unistd.h>
 #include <vector>
-#include <sstream>
 #include <sys/socket.h>
 #include <arpa/inet.h>
 #include <errno.h>
@@ -19,6 +19,7 @@ Server::Server(int port, const ServerConfig& config)
     : server_socket()
     , port(port)
     , running(false)
+    , accept_budget(MIN_ACCEPT_BUDGET)
     , server_config(config)
     , route_handler(config.root_directory, config) {
 }
@@ -30,20 +31,37 @@ Server::~Server() {
     if (running) {
         server_socket.close();
     }
-    client_requests.clear();
+    
+    // Bilan du cache de réponses
+    const ResponseCache& cache = route_handler.getResponseCache();
+    if (cache.enabled()) {
+        LOG_INFO("Response cache on port " << port << ": " << cache.getHits() << " hits, "
+                 << cache.getMisses() << " misses (hit ratio " << static_cast<int>(cache.hitRatio() * 100) << "%)");
+    }
 }
 
 /**
  * @brief Initialise le serveur
  */
-void Server::initialize() {
+void Server::initialize(bool reuse_port) {
     try {
         server_socket.create();
         server_socket.setReuseAddr(true);
+        if (reuse_port) {
+            // Chaque worker ouvre son propre socket d'écoute sur le même port,
+            // le noyau répartit les connexions entre eux
+            server_socket.setReusePort(true);
+        }
         server_socket.bind(port);
         server_socket.listen();
         server_socket.setNonBlocking(true);
         
+        // Surveillance des fichiers créée ici : chaque worker a la sienne
+        if (server_config.response_cache > 0 && !route_handler.getResponseCache().start()) {
+            LOG_WARNING("inotify unavailable, response cache disabled: " << strerror(errno));
+        }
+        route_handler.loadErrorPages();
+        
         running = true;
     } catch (const std::exception& e) {
         LOG_ERROR("Server initialization error: " << e.what());
@@ -61,69 +79,103 @@ void Server::stop() {
 /**
  * @brief Accepte une nouvelle connexion client
  * @return Le descripteur du nouveau client ou -1 en cas d'erreur
+ * 
+ * Sous Linux, accept4() rend le socket non-bloquant et close-on-exec en un
+ * seul appel système (les processus CGI n'héritent pas des sockets clients).
  */
 int Server::acceptNewConnection() {
     struct sockaddr_in client_addr;
     socklen_t client_addr_len = sizeof(client_addr);
     
+#ifdef SOCK_NONBLOCK
+    int client_fd = accept4(server_socket.getFd(), (struct sockaddr*)&client_addr, &client_addr_len,
+                            SOCK_NONBLOCK | SOCK_CLOEXEC);
+#else
     int client_fd = accept(server_socket.getFd(), (struct sockaddr*)&client_addr, &client_addr_len);
+    if (client_fd >= 0) {
+        // Configurer le socket client comme non-bloquant
+        fcntl(client_fd, F_SETFL, O_NONBLOCK);
+        fcntl(client_fd, F_SETFD, FD_CLOEXEC);
+    }
+#endif
     if (client_fd < 0) {
-        if (errno != EAGAIN && errno != EWOULDBLOCK) {
-            perror("accept");
-        }
-        return -1;
+        return -1; // errno positionné, traité par l'appelant
     }
     
-    // Configurer le socket client comme non-bloquant
-    fcntl(client_fd, F_SETFL, O_NONBLOCK);
-    
     // Obtenir et afficher l'adresse IP du client
     char client_ip[INET_ADDRSTRLEN];
     inet_ntop(AF_INET, &(client_addr.sin_addr), client_ip, INET_ADDRSTRLEN);
     LOG_NETWORK("Client " << client_ip << " [" << client_fd << "]");
     
-    // Initialiser la requête pour ce client
-    client_requests[client_fd] = "";
-    
     return client_fd;
 }
 
 /**
- * @brief Ferme une connexion client
+ * @brief Ajuste le nombre d'accept() par réveil selon la file d'attente observée
+ * @param accepted Connexions acceptées pendant ce réveil
+ * @param drained true si la file d'attente a été vidée (EAGAIN)
  */
-void Server::closeClientConnection(int client_fd) {
-    if (client_fd >= 0) {
-        close(client_fd);
-        client_requests.erase(client_fd);
+void Server::adjustAcceptBudget(int accepted, bool drained) {
+    if (!drained && accept_budget < MAX_ACCEPT_BUDGET) {
+        accept_budget *= 2; // Budget épuisé avant la fin de la file : accepter plus la prochaine fois
+    } else if (drained && accepted < accept_budget / 4 && accept_budget > MIN_ACCEPT_BUDGET) {
+        accept_budget /= 2;
+    }
+}
+
+/**
+ * @brief Refuse une connexion quand le serveur est saturé
+ * 
+ * Une réponse 503 est tentée sans bloquer, puis le socket est fermé
+ * immédiatement : aucun slot ni fd n'est consommé.
+ */
+void Server::rejectConnection(int client_fd) {
+    if (overload_response.empty()) {
+        HttpResponse response = route_handler.serveErrorPage(503, "Service Unavailable");
+        response.setHeader("Connection", "close");
+        response.setHeader("Retry-After", "1");
+        overload_response = response.build();
+    }
+    
+    send(client_fd, overload_response.data(), overload_response.size(), MSG_NOSIGNAL | MSG_DONTWAIT);
+    close(client_fd);
+}
+
+/**
+ * @brief Ferme le socket d'une connexion client (le slot est libéré par l'appelant)
+ */
+void Server::closeClientConnection(Connection& conn) {
+    if (conn.fd >= 0) {
+        close(conn.fd);
         // Pas besoin de log quand un client se déconnecte
     }
 }
 
 /**
  * @brief Traite les données reçues d'un client
+ * 
+ * Lit les octets disponibles sans jamais bloquer ni dormir : sur EAGAIN la
+ * main est rendue à la boucle d'événements et la lecture reprendra au
+ * prochain POLLIN, là où la machine à états de la connexion s'était arrêtée.
  * @return false si la connexion doit être fermée, true sinon
  */
-bool Server::handleClientData(int client_fd) {
+bool Server::handleClientData(Connection& conn) {
     char buffer[BUFFER_SIZE];
-    std::string& raw_request = client_requests[client_fd];
-    size_t content_length = 0;
-    bool headers_complete = false;
-    int retry_count = 0;
-    const int MAX_RETRIES = 10; // Réduit car 1000 est excessif
+    int client_fd = conn.fd;
+    
+    // Une réponse "Connection: close" est en cours d'envoi : ignorer la suite,
+    // ou la lire pour la jeter si la requête a été refusée avant la fin de son envoi
+    if (conn.close_after_write) {
+        return conn.lingering_close ? discardClientData(conn) : true;
+    }
     
-    while (true) {
+    for (int reads = 0; reads < MAX_READS_PER_EVENT && !conn.isComplete() && !conn.hasError(); reads++) {
         // Recevoir les données
-        int nbytes = recv(client_fd, buffer, sizeof(buffer) - 1, 0);
+        ssize_t nbytes = recv(client_fd, buffer, sizeof(buffer), 0);
         
         if (nbytes < 0) {
             if (errno == EAGAIN || errno == EWOULDBLOCK) {
-                retry_count++;
-                if (retry_count > MAX_RETRIES) {
-                    LOG_ERROR("Max retries reached while reading from client");
-                    return false;
-                }
-                usleep(1000); // Attendre 1ms avant de réessayer
-                continue;
+                break; // Plus rien à lire pour l'instant, retour à la boucle
             }
             LOG_NETWORK("Client disconnected: " << strerror(errno));
             return false;
@@ -133,113 +185,303 @@ bool Server::handleClientData(int client_fd) {
             return false;
         }
         
-        retry_count = 0; // Réinitialiser le compteur après une lecture réussie
-        raw_request.append(buffer, nbytes);
-        
-        // Si nous n'avons pas encore trouvé la fin des headers
-        if (!headers_complete) {
-            size_t headers_end = raw_request.find("\r\n\r\n");
-            if (headers_end != std::string::npos) {
-                headers_complete = true;
-                
-                // Chercher Content-Length dans les headers
-                size_t cl_pos = raw_request.find("Content-Length:");
-                if (cl_pos != std::string::npos) {
-                    size_t cl_end = raw_request.find("\r\n", cl_pos);
-                    if (cl_end != std::string::npos) {
-                        std::string cl_str = raw_request.substr(cl_pos + 15, cl_end - (cl_pos + 15));
-                        // Supprimer les espaces
-                        cl_str.erase(0, cl_str.find_first_not_of(" \t"));
-                        cl_str.erase(cl_str.find_last_not_of(" \t") + 1);
-                        
-                        std::stringstream ss(cl_str);
-                        ss >> content_length;
-                    }
-                }
-                
-                // Vérifier si on a déjà reçu toutes les données
-                if (content_length == 0 || raw_request.size() >= (headers_end + 4 + content_length)) {
-                    break; // On a toutes les données nécessaires
-                }
+        conn.read_buffer.append(buffer, nbytes);
+        conn.advance();
+    }
+    
+    return processPipeline(conn);
+}
+
+/**
+ * @brief Traite, dans l'ordre, les requêtes complètes présentes dans le tampon
+ * 
+ * Un client peut envoyer plusieurs requêtes sans attendre les réponses
+ * (pipelining) : chacune ne consomme que ses propres octets et les réponses
+ * sont mises en file dans l'ordre des requêtes. Au-delà de
+ * max_pipelined_requests réponses en attente, le traitement et la lecture
+ * sont suspendus jusqu'à ce que le client lise ses réponses.
+ * @return false si la connexion doit être fermée, true sinon
+ */
+bool Server::processPipeline(Connection& conn) {
+    while (!conn.close_after_write) {
+        // En-têtes avec "Expect: 100-continue" reçus : répondre avant que le client n'envoie le body
+        if (conn.expect_continue) {
+            answerExpectation(conn);
+        }
+        if (!conn.isComplete() && !conn.hasError()) {
+            break;
+        }
+        if (conn.outbound.responses() >= server_config.max_pipelined_requests) {
+            if (!flushOutput(conn)) {
+                return false;
             }
-        } else {
-            // Vérifier si on a reçu toutes les données du body
-            size_t headers_end = raw_request.find("\r\n\r\n");
-            if (headers_end != std::string::npos && raw_request.size() >= (headers_end + 4 + content_length)) {
-                break; // On a toutes les données nécessaires
+            if (conn.outbound.responses() >= server_config.max_pipelined_requests) {
+                break; // Le client ne lit plus ses réponses : reprendre au prochain POLLOUT
             }
         }
+        if (!processRequest(conn)) {
+            return false;
+        }
+    }
+    
+    if (!flushOutput(conn)) {
+        return false;
+    }
+    if (conn.close_after_write && conn.outbound.empty()) {
+        return startLingeringClose(conn);
+    }
+    return true;
+}
+
+/**
+ * @brief Répond à "Expect: 100-continue" dès la fin des en-têtes
+ * 
+ * La taille annoncée a déjà été vérifiée (413) ; la méthode est vérifiée
+ * ici pour la location. Le client reçoit soit "100 Continue", soit le
+ * statut d'erreur final, sans avoir transféré son body. Si le body a déjà
+ * commencé à arriver, le 100 est inutile et n'est pas envoyé.
+ */
+void Server::answerExpectation(Connection& conn) {
+    conn.expect_continue = false;
+    if (conn.isComplete() || conn.hasError()) {
+        return;
+    }
+    
+    const char* data = conn.read_buffer.data();
+    std::string uri = conn.parser.getTarget().str(data);
+    size_t query_pos = uri.find('?');
+    if (query_pos != std::string::npos) {
+        uri.erase(query_pos);
+    }
+    
+    int error_code = route_handler.checkMethod(conn.parser.getMethod().str(data), uri);
+    if (error_code != 0) {
+        conn.rejectRequest(error_code);
+    } else if (!conn.bodyStarted()) {
+        std::string continue_response = "HTTP/1.1 100 Continue\r\n\r\n";
+        queueResponse(conn, continue_response);
+    }
+}
+
+/**
+ * @brief Ferme la connexion une fois la dernière réponse envoyée
+ * 
+ * Fermer un socket dont des octets n'ont pas été lus envoie un RST, et le
+ * client qui est encore en train d'envoyer son body perd la réponse
+ * d'erreur. Après une requête refusée, seul le sens serveur -> client est
+ * fermé ; la suite de la requête est lue puis jetée jusqu'à ce que le
+ * client ferme, ou au plus LINGERING_TIMEOUT.
+ * @return false si la connexion doit être fermée immédiatement
+ */
+bool Server::startLingeringClose(Connection& conn) {
+    if (!conn.lingering_close) {
+        return false;
+    }
+    shutdown(conn.fd, SHUT_WR);
+    return true;
+}
+
+/**
+ * @brief Lit et jette les octets envoyés après une requête refusée
+ * @return false si la connexion doit être fermée, true sinon
+ */
+bool Server::discardClientData(Connection& conn) {
+    char buffer[BUFFER_SIZE];
+    
+    for (int reads = 0; reads < MAX_READS_PER_EVENT; reads++) {
+        ssize_t nbytes = recv(conn.fd, buffer, sizeof(buffer), 0);
+        if (nbytes < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        }
+        if (nbytes <= 0) {
+            // Le client a fini : fermer dès que la réponse est partie
+            conn.lingering_close = false;
+            return !conn.outbound.empty();
+        }
     }
+    return true;
+}
+
+/**
+ * @brief Traite la requête complète en tête du tampon et met sa réponse en file
+ * @return false si la connexion doit être fermée, true sinon
+ */
+bool Server::processRequest(Connection& conn) {
+    const char* data = conn.read_buffer.data();
+    const RequestParser& parser = conn.parser;
     
-    // Traiter la requête complète
     HttpRequest request;
+    bool parsed = false;
 
-    // Extraire l'URI pour pouvoir déterminer la taille maximale du corps autorisée
-    std::string method, uri, version;
-    size_t first_line_end = raw_request.find("\r\n");
-    if (first_line_end != std::string::npos) {
-        std::string request_line = raw_request.substr(0, first_line_end);
-        std::istringstream iss(request_line);
-        iss >> method >> uri >> version;
+    if (!conn.hasError()) {
+        // Déterminer la taille maximale du corps autorisée d'après la location de l'URI
+        request.setMaxBodySize(conn.max_body_size);
         
-        // Si on a pu extraire l'URI, chercher la configuration de location correspondante
-        if (!uri.empty()) {
-            const LocationConfig* location = route_handler.findMatchingLocation(uri);
-            if (location) {
-                // Définir la taille maximale du corps autorisée pour cette location
-                request.setMaxBodySize(location->client_max_body_size);
-                // LOG désactivé pour réduire le bruit
-                // LOG_INFO("Setting max body size for " << uri << " to " << location->client_max_body_size << " bytes");
-            }
-        }
+        // Construire la requête depuis les positions relevées par le parser, sans re-parsing.
+        // Seuls ses octets sont pris en compte : la suite du tampon appartient à la requête suivante.
+        // Un body chunked a déjà été décodé hors du tampon au fil de la réception
+        parsed = request.parse(data, parser.getRequestSize(), parser,
+                               parser.isChunked() ? &conn.body : NULL);
     }
 
-    if (request.parse(raw_request)) {
-        // Nettoyer la requête après traitement
-        client_requests[client_fd] = "";
+    if (parsed) {
+        // Retirer la requête du tampon et commencer le parsing de la suivante
+        conn.consumeRequest();
+        conn.requests_served++;
         
         try {
-            sendHttpResponse(client_fd, request);
+            sendHttpResponse(conn, request);
         } catch (const std::exception& e) {
             LOG_ERROR("Error sending response: " << e.what());
             return false;
         }
     } else {
-        // Requête invalide
+        // Requête invalide : 400 par défaut, ou le code relevé (413, 414, 431...)
+        int error_code = conn.hasError() ? parser.getErrorCode() : request.getErrorCode();
+        if (error_code == 0) {
+            error_code = 400;
+        }
         LOG_ERROR("Invalid HTTP request format");
         
-        // Créer une réponse d'erreur 400 Bad Request
-        HttpResponse response;
-        response.setStatus(400);
+        // Page d'erreur préchargée (error_page) ou par défaut, comme pour les autres erreurs
+        HttpResponse response = route_handler.serveErrorPage(error_code, "");
         response.setHeader("Connection", "close");
         
-        std::string error_body = "<html><body><h1>400 Bad Request</h1></body></html>";
-        response.setBody(error_body);
-        
         // Journaliser la réponse d'erreur avec un format uniforme
         std::cout << YELLOW << "→ ERROR" << RESET << " Invalid Request" << RESET << std::endl;
-        std::cout << RED << "  ↳ 400 • Bad Request" << RESET << std::endl;
+        std::cout << RED << "  ↳ " << error_code << " • " << response.getStatusMessage() << RESET << std::endl;
         
-        // Envoyer la réponse d'erreur
+        // Envoyer la réponse d'erreur puis fermer une fois la file vidée ; le
+        // client peut être en train d'envoyer un body, qui sera lu et jeté
+        conn.close_after_write = true;
+        conn.lingering_close = true;
         try {
-            std::string http_response = response.build();
-            send(client_fd, http_response.c_str(), http_response.size(), 0);
+            queueResponse(conn, response);
         } catch (const std::exception& e) {
             LOG_ERROR("Error sending error response: " << e.what());
         }
         
         // Nettoyer la requête
-        client_requests[client_fd] = "";
-        return false;
+        conn.resetRequest();
     }
     
     return true;
 }
 
+/**
+ * @brief Taille maximale du body autorisée pour une URI
+ * 
+ * Connue dès la fin des en-têtes : un body chunked est limité pendant son
+ * décodage, sans attendre la fin de la requête.
+ */
+size_t Server::getMaxBodySize(const std::string& uri) const {
+    const LocationConfig* location = route_handler.findMatchingLocation(uri);
+    if (location) {
+        return location->client_max_body_size;
+    }
+    return HttpRequest::DEFAULT_MAX_BODY_SIZE;
+}
+
+/**
+ * @brief Met une réponse en file d'attente pour ce client
+ * 
+ * L'envoi effectif est fait par flushOutput(), puis repris à chaque POLLOUT
+ * tant que la file n'est pas vide. Réservé aux réponses intermédiaires
+ * (100 Continue) : elles ne comptent pas dans max_pipelined_requests.
+ */
+void Server::queueResponse(Connection& conn, std::string& raw_response) {
+    conn.outbound.enqueue(raw_response);
+}
+
+/**
+ * @brief Met une réponse en file : en-têtes sérialisés dans le tampon
+ *        réutilisable de la connexion, body transféré sans copie (ou
+ *        référence au fichier à envoyer)
+ */
+void Server::queueResponse(Connection& conn, HttpResponse& response) {
+    if (response.hasPrebuilt()) {
+        // Réponse du cache mémoire : partagée telle quelle, seules la ligne de statut et Date sont écrites
+        response.serializeStatusLine(conn.outbound.headerBuffer());
+        conn.outbound.enqueueResponse(response.getPrebuilt());
+        conn.outbound.endResponse();
+        return;
+    }
+    std::string& head = conn.outbound.headerBuffer();
+    response.serializeHeaders(head);
+    const std::vector<FilePart>& parts = response.getFileParts();
+    if (response.hasFileBody() && !parts.empty()) {
+        // multipart/byteranges : en-têtes de chaque partie, puis sa portion du fichier
+        for (size_t i = 0; i < parts.size(); i++) {
+            // La première partie suit les en-têtes de la réponse, les suivantes ont leur tampon
+            std::string& part_head = i == 0 ? head : conn.outbound.headerBuffer();
+            part_head.append(parts[i].head);
+            conn.outbound.enqueueResponse(response.getFileBody(), parts[i].offset, parts[i].length);
+        }
+    } else if (response.hasFileBody()) {
+        // Fichier statique : envoyé par sendfile(), jamais chargé en mémoire
+        conn.outbound.enqueueResponse(response.getFileBody(), response.getFileOffset(), response.getFileLength());
+    } else if (response.hasSharedBody()) {
+        // Page d'erreur préchargée : le tampon est partagé, pas recopié
+        conn.outbound.enqueueResponse(response.getSharedBody());
+    } else {
+        std::string body;
+        response.takeBody(body);
+        conn.outbound.enqueueResponse(body);
+    }
+    // Une seule réponse pour max_pipelined_requests, quel que soit son nombre d'éléments
+    conn.outbound.endResponse();
+}
+
+/**
+ * @brief Envoie ce que le socket accepte sans bloquer
+ * @return false si l'envoi a échoué et que la connexion doit être fermée
+ */
+bool Server::flushOutput(Connection& conn) {
+    if (conn.outbound.empty()) {
+        return true;
+    }
+    if (conn.outbound.flush(conn.fd) == OutboundQueue::FLUSH_ERROR) {
+        LOG_ERROR("Failed to send response: " << strerror(errno));
+        conn.outbound.clear();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Reprend l'envoi des réponses en attente quand le socket est inscriptible
+ * @return false si la connexion doit être fermée, true sinon
+ */
+bool Server::handleClientWrite(Connection& conn) {
+    if (!flushOutput(conn)) {
+        return false;
+    }
+    // Des requêtes mises en attente par la limite de pipelining peuvent reprendre
+    return processPipeline(conn);
+}
+
+/**
+ * @brief Détermine les événements à surveiller pour un client
+ * 
+ * POLLOUT n'est demandé que lorsqu'une réponse attend d'être envoyée ;
+ * la lecture est suspendue quand la connexion doit être fermée après l'envoi
+ * (sauf pour jeter la suite d'une requête refusée) ou quand la limite de
+ * requêtes pipelinées en attente est atteinte.
+ */
+int Server::getClientEvents(const Connection& conn) const {
+    bool can_read = conn.close_after_write ? conn.lingering_close
+                  : conn.outbound.responses() < server_config.max_pipelined_requests;
+    int events = can_read ? Poller::EVENT_READ : 0;
+    if (!conn.outbound.empty()) {
+        events |= Poller::EVENT_WRITE;
+    }
+    return events;
+}
+
 /**
  * @brief Envoie une réponse HTTP au client
  */
-void Server::sendHttpResponse(int client_fd, const HttpRequest& request) {
+void Server::sendHttpResponse(Connection& conn, const HttpRequest& request) {
     try {
         // Traiter la requête avec le routeur
         HttpResponse response = route_handler.processRequest(request);
@@ -256,31 +498,20 @@ void Server::sendHttpResponse(int client_fd, const HttpRequest& request) {
          response.getStatus() >= 400 ? RED : BLUE) 
         << "  ↳ " << response.getStatus() << " • " << response.getStatusMessage() << RESET << std::endl;
         
-        // Convertir la réponse en chaîne et l'envoyer
-        std::string http_response = response.build();
-        
-        // Envoyer la réponse au client
-        ssize_t sent = send(client_fd, http_response.c_str(), http_response.size(), 0);
-        
-        if (sent < 0) {
-            LOG_ERROR("Failed to send response: " << strerror(errno));
-        } else {
-            // Si c'est une requête "Connection: close", fermer la connexion
-            if (request.getHeader("connection") == "close" || response.getHeader("Connection") == "close") {
-                return;
-            }
+        // Si c'est une requête "Connection: close", fermer la connexion après l'envoi
+        if (request.getHeader(HEADER_CONNECTION) == "close" || response.getHeader("Connection") == "close") {
+            conn.close_after_write = true;
         }
+        
+        // Mettre la réponse en file d'envoi (en-têtes et body sans concaténation)
+        queueResponse(conn, response);
     } catch (const std::exception& e) {
         LOG_ERROR("Error processing request: " << e.what());
         
         // Créer une réponse d'erreur 500
-        HttpResponse error_response;
-        error_response.setStatus(500);
+        HttpResponse error_response = route_handler.serveErrorPage(500, "");
         error_response.setHeader("Connection", "close");
         
-        std::string error_body = "<html><body><h1>500 Internal Server Error</h1></body></html>";
-        error_response.setBody(error_body);
-        
         // Journaliser la réponse d'erreur avec le même format uniforme
         std::cout << 
         (std::string(request.getMethod()) == "GET" ? COLOR_GET : 
@@ -290,12 +521,8 @@ void Server::sendHttpResponse(int client_fd, const HttpRequest& request) {
         std::cout << RED << "  ↳ 500 • Internal Server Error" << RESET << std::endl;
         
         // Envoyer la réponse d'erreur
-        std::string http_response = error_response.build();
-        ssize_t sent = send(client_fd, http_response.c_str(), http_response.size(), 0);
-        
-        if (sent < 0) {
-            LOG_ERROR("Failed to send error response: " << strerror(errno));
-        }
+        conn.close_after_write = true;
+        queueResponse(conn, error_response);
     }
 }
 
@@ -313,26 +540,44 @@ bool Server::matchesSocketFd(int fd) const {
     return server_socket.getFd() == fd;
 }
 
+/**
+ * @brief Descripteur inotify à surveiller dans la boucle d'événements
+ */
+int Server::getWatchFd() const {
+    return route_handler.getResponseCache().getWatchFd();
+}
+
+/**
+ * @brief Traite les modifications de fichiers signalées par inotify
+ */
+void Server::handleFileEvents() {
+    route_handler.handleFileEvents();
+}
+
+/**
+ * @brief Relit les pages d'erreur configurées (demandé par SIGHUP)
+ */
+void Server::reloadErrorPages() {
+    size_t loaded = route_handler.loadErrorPages();
+    LOG_INFO("Server on port " << port << ": " << loaded << " error page(s) reloaded");
+}
+
 // Traitement d'une requête complète
-void Server::processCompleteRequest(int client_fd, const std::string& raw_request) {
+void Server::processCompleteRequest(Connection& conn, const std::string& raw_request) {
     HttpRequest request;
     if (!request.parse(raw_request)) {
         // Requête invalide
-        HttpResponse response;
-        response.setStatus(400);
+        HttpResponse response = route_handler.serveErrorPage(400, "");
         response.setHeader("Connection", "close");
         
-        std::string error_body = "<html><body><h1>400 Bad Request</h1></body></html>";
-        response.setBody(error_body);
-        
         // Journaliser la réponse d'erreur
         LOG_INFO("Invalid Request");
         LOG_ERROR("400 • Bad Request");
         
         // Envoyer la réponse d'erreur
         try {
-            std::string http_response = response.build();
-            send(client_fd, http_response.c_str(), http_response.size(), 0);
+            conn.close_after_write = true;
+            queueResponse(conn, response);
         } catch (const std::exception& e) {
             LOG_ERROR("Error sending error response: " << e.what());
         }
@@ -343,7 +588,7 @@ void Server::processCompleteRequest(int client_fd, const std::string& raw_reques
     LOG_INFO("Received " << request.getMethod() << " request for " << request.getUri());
     
     // Vérifier si l'hôte est autorisé
-    std::string host = request.getHeader("host");
+    std::string host = request.getHeader(HEADER_HOST);
     bool host_allowed = server_config.server_names.empty(); // Si pas de noms définis, accepter tout
     
     if (!host_allowed && !host.empty()) {
@@ -365,17 +610,13 @@ void Server::processCompleteRequest(int client_fd, const std::string& raw_reques
     
     if (!host_allowed) {
         // Créer une réponse 403 Forbidden
-        HttpResponse response;
-        response.setStatus(403);
+        HttpResponse response = route_handler.serveErrorPage(403, "");
         response.setHeader("Connection", "close");
         
-        std::string error_body = "<html><body><h1>403 Forbidden</h1></body></html>";
-        response.setBody(error_body);
-        
         // Envoyer la réponse
         try {
-            std::string http_response = response.build();
-            send(client_fd, http_response.c_str(), http_response.size(), 0);
+            conn.close_after_write = true;
+            queueResponse(conn, response);
         } catch (const std::exception& e) {
             LOG_ERROR("Error sending forbidden response: " << e.what());
         }
@@ -384,25 +625,103 @@ void Server::processCompleteRequest(int client_fd, const std::string& raw_reques
     
     // Traiter la requête et envoyer la réponse
     try {
-        sendHttpResponse(client_fd, request);
+        sendHttpResponse(conn, request);
     } catch (const std::exception& e) {
         LOG_ERROR("Error processing request: " << e.what());
     }
 }
 
-// Gère un timeout de client
-void Server::handleClientTimeout(int client_fd) {
+/**
+ * @brief Détermine le timeout applicable à l'état courant d'un client
+ */
+Connection::TimerPhase Server::timerPhase(const Connection& conn) const {
+    if (!conn.outbound.empty()) {
+        return Connection::TIMER_SEND;
+    }
+    if (conn.close_after_write) {
+        return conn.lingering_close ? Connection::TIMER_LINGER : Connection::TIMER_NONE;
+    }
+    if (conn.read_state == Connection::READ_BODY) {
+        return Connection::TIMER_BODY;
+    }
+    if (conn.read_buffer.empty() && conn.requests_served > 0) {
+        return Connection::TIMER_KEEPALIVE;
+    }
+    return Connection::TIMER_HEADER;
+}
+
+/**
+ * @brief (Ré)arme le timer d'un client après un événement
+ * 
+ * client_header_timeout couvre la réception de tous les en-têtes et n'est
+ * armé qu'à l'entrée dans cet état ; client_body_timeout et send_timeout
+ * mesurent l'inactivité et sont réarmés à chaque progression.
+ */
+void Server::updateClientTimer(Connection& conn, TimerWheel& timers) {
+    int client_fd = conn.fd;
+    
+    Connection::TimerPhase phase = timerPhase(conn);
+    if (phase == conn.timer_phase && phase != Connection::TIMER_BODY && phase != Connection::TIMER_SEND
+        && timers.isScheduled(client_fd)) {
+        return;
+    }
+    conn.timer_phase = phase;
+    
+    switch (phase) {
+        case Connection::TIMER_HEADER:
+            timers.schedule(client_fd, server_config.client_header_timeout);
+            break;
+        case Connection::TIMER_BODY:
+            timers.schedule(client_fd, server_config.client_body_timeout);
+            break;
+        case Connection::TIMER_KEEPALIVE:
+            timers.schedule(client_fd, server_config.keepalive_timeout);
+            break;
+        case Connection::TIMER_SEND:
+            timers.schedule(client_fd, server_config.send_timeout);
+            break;
+        case Connection::TIMER_LINGER:
+            timers.schedule(client_fd, LINGERING_TIMEOUT);
+            break;
+        default:
+            timers.cancel(client_fd);
+            break;
+    }
+}
+
+/**
+ * @brief Gère l'expiration du timer d'un client
+ * 
+ * Une requête entamée mais incomplète reçoit un 408 avant la fermeture ;
+ * une connexion keep-alive inactive, un client qui ne lit plus sa
+ * réponse ou qui envoie encore le body d'une requête refusée est
+ * simplement fermé.
+ * @return false si la connexion doit être fermée immédiatement
+ */
+bool Server::handleClientTimeout(Connection& conn) {
+    if (conn.timer_phase == Connection::TIMER_SEND || conn.timer_phase == Connection::TIMER_KEEPALIVE
+        || conn.timer_phase == Connection::TIMER_LINGER || conn.read_buffer.empty()) {
+        LOG_NETWORK("Client timed out, fd: " << conn.fd);
+        return false;
+    }
+    
     // Créer une réponse d'erreur 408 Request Timeout
     HttpResponse error_response = route_handler.serveErrorPage(408, "Request Timeout");
+    error_response.setHeader("Connection", "close");
+    std::cout << RED << "  ↳ 408 • Request Timeout" << RESET << std::endl;
     
-    // Envoyer la réponse d'erreur
+    // Envoyer la réponse d'erreur puis fermer une fois la file vidée
     try {
-        std::string http_response = error_response.build();
-        send(client_fd, http_response.c_str(), http_response.size(), 0);
+        conn.resetRequest();
+        conn.close_after_write = true;
+        queueResponse(conn, error_response);
     } catch (const std::exception& e) {
         LOG_ERROR("Error sending timeout response: " << e.what());
+        return false;
     }
     
-    // Fermer la connexion
-    closeClientConnection(client_fd);
-}
\ No newline at end of file
+    if (!flushOutput(conn)) {
+        return false;
+    }
+    return !conn.outbound.empty();
+}
@@ -24,6 +24,7 @@ WebservConfig ConfigParser::parseFile(const std::string& filename) {
     int brace_level = 0;
     bool in_server = false;
     bool in_location = false;
+    bool in_types = false;
 
     std::string line;
     try {
@@ -38,7 +39,7 @@ WebservConfig ConfigParser::parseFile(const std::string& filename) {
             
             // Traitement des accolades et des directives
             parseNewSyntax(line, config, current_server, current_location, 
-                        location_path, in_server, in_location, brace_level);
+                        location_path, in_server, in_location, in_types, brace_level);
         }
         
         // Vérifier que toutes les accolades sont fermées
@@ -67,7 +68,7 @@ WebservConfig ConfigParser::parseFile(const std::string& filename) {
 void ConfigParser::parseNewSyntax(const std::string& line, WebservConfig& config,
                                ServerConfig& current_server, LocationConfig& current_location,
                                std::string& location_path, bool& in_server, bool& in_location,
-                               int& brace_level) {
+                               bool& in_types, int& brace_level) {
     // Extraction des tokens principaux (avant les commentaires)
     std::string content = line;
     size_t comment_pos = content.find('#');
@@ -77,6 +78,27 @@ void ConfigParser::parseNewSyntax(const std::string& line, WebservConfig& config
         if (content.empty()) return;
     }
     
+    // Contenu du bloc types : une déclaration "type ext1 ext2;" par ligne
+    if (in_types) {
+        if (content.find("}") != std::string::npos) {
+            in_types = false;
+            brace_level--;
+            return;
+        }
+        addMimeTypes(content, config.mime_types);
+        return;
+    }
+
+    // Détection d'ouverture du bloc des types MIME: "types {"
+    if (content.find("types") == 0 && content.find("{") != std::string::npos) {
+        if (in_server) {
+            throw std::runtime_error("types block must be outside of server blocks");
+        }
+        in_types = true;
+        brace_level++;
+        return;
+    }
+
     // Détection d'ouverture de bloc serveur: "server {"
     if (content.find("server") == 0 && content.find("{") != std::string::npos) {
         if (in_server) {
@@ -136,10 +158,11 @@ void ConfigParser::parseNewSyntax(const std::string& line, WebservConfig& config
     }
     
     // Traitement des directives (clé=valeur ou clé valeur)
-    parseDirective(content, in_server, in_location, current_server, current_location);
+    parseDirective(content, config, in_server, in_location, current_server, current_location);
 }
 
-void ConfigParser::parseDirective(const std::string& line, bool in_server, bool in_location,
+void ConfigParser::parseDirective(const std::string& line, WebservConfig& config,
+                               bool in_server, bool in_location,
                                ServerConfig& server, LocationConfig& location) {
     // Format flexible: clé=valeur ou clé valeur
     std::string key, value;
@@ -168,11 +191,101 @@ void ConfigParser::parseDirective(const std::string& line, bool in_server, bool
         processLocationDirective(key, value, location);
     } else if (in_server) {
         processServerDirective(key, value, server);
+    } else {
+        processGlobalDirective(key, value, config);
+    }
+}
+
+void ConfigParser::processGlobalDirective(const std::string& key, const std::string& value,
+                                       WebservConfig& config) {
+    if (key == "event_backend") {
+        if (value != "epoll" && value != "poll") {
+            throw std::runtime_error("Invalid event_backend (should be: epoll or poll)");
+        }
+        config.event_backend = value;
+    } else if (key == "worker_processes") {
+        if (value == "auto") {
+            config.worker_processes = 0;
+        } else {
+            int workers = atoi(value.c_str());
+            if (value.find_first_not_of("0123456789") != std::string::npos || workers < 1) {
+                throw std::runtime_error("Invalid worker_processes (should be: a positive number or auto)");
+            }
+            config.worker_processes = workers;
+        }
+    } else if (key == "mime_types") {
+        loadMimeTypesFile(value, config.mime_types);
     } else {
         throw std::runtime_error("Directive outside of server or location block: " + key);
     }
 }
 
+void ConfigParser::addMimeTypes(const std::string& statement, std::map<std::string, std::string>& mime_types) {
+    std::string content = trim(statement);
+    if (!content.empty() && content[content.size() - 1] == ';') {
+        content.erase(content.size() - 1);
+    }
+
+    std::istringstream iss(content);
+    std::string type, extension;
+    iss >> type;
+    if (type.find('/') == std::string::npos || type[0] == '/' || type[type.size() - 1] == '/') {
+        throw std::runtime_error("Invalid MIME type: " + type);
+    }
+    bool has_extension = false;
+    while (iss >> extension) {
+        if (extension[0] == '.') {
+            extension.erase(0, 1);
+        }
+        if (extension.empty() || extension.find_first_of("./") != std::string::npos) {
+            throw std::runtime_error("Invalid extension for " + type);
+        }
+        std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+        mime_types[extension] = type;
+        has_extension = true;
+    }
+    if (!has_extension) {
+        throw std::runtime_error("No extension given for MIME type " + type);
+    }
+}
+
+/**
+ * @brief Les déclarations peuvent s'étendre sur plusieurs lignes jusqu'au ';'
+ */
+void ConfigParser::loadMimeTypesFile(const std::string& path, std::map<std::string, std::string>& mime_types) {
+    std::ifstream file(path.c_str());
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open mime_types file: " + path);
+    }
+
+    std::string line, statement;
+    while (std::getline(file, line)) {
+        size_t comment_pos = line.find('#');
+        if (comment_pos != std::string::npos) {
+            line.erase(comment_pos);
+        }
+        for (size_t i = 0; i < line.size(); i++) {
+            if (line[i] == '{') {
+                statement.clear(); // Mot-clé "types" avant le bloc
+            } else if (line[i] == '}') {
+                if (!trim(statement).empty()) {
+                    throw std::runtime_error("Missing ';' in mime_types file: " + path);
+                }
+                statement.clear();
+            } else if (line[i] == ';') {
+                addMimeTypes(statement, mime_types);
+                statement.clear();
+            } else {
+                statement += line[i];
+            }
+        }
+        statement += ' ';
+    }
+    if (!trim(statement).empty()) {
+        throw std::runtime_error("Unterminated declaration in mime_types file: " + path);
+    }
+}
+
 void ConfigParser::processServerDirective(const std::string& key, const std::string& value,
                                        ServerConfig& server) {
     if (key == "port") {
@@ -196,6 +309,44 @@ void ConfigParser::processServerDirective(const std::string& key, const std::str
         }
         int code = atoi(parts[0].c_str());
         server.error_pages[code] = parts[1];
+    } else if (key == "client_header_timeout") {
+        server.client_header_timeout = parseTime(value);
+    } else if (key == "client_body_timeout") {
+        server.client_body_timeout = parseTime(value);
+    } else if (key == "keepalive_timeout") {
+        server.keepalive_timeout = parseTime(value);
+    } else if (key == "send_timeout") {
+        server.send_timeout = parseTime(value);
+    } else if (key == "max_pipelined_requests") {
+        int max_requests = atoi(value.c_str());
+        if (max_requests <= 0 || value.find_first_not_of("0123456789") != std::string::npos) {
+            throw std::runtime_error("Invalid max_pipelined_requests (should be a positive number)");
+        }
+        server.max_pipelined_requests = static_cast<size_t>(max_requests);
+    } else if (key == "open_file_cache") {
+        if (value.empty() || value.find_first_not_of("0123456789") != std::string::npos) {
+            throw std::runtime_error("Invalid open_file_cache (should be a number of entries, 0 to disable)");
+        }
+        server.open_file_cache = static_cast<size_t>(atol(value.c_str()));
+    } else if (key == "open_file_cache_valid") {
+        server.open_file_cache_valid = parseTime(value);
+    } else if (key == "response_cache") {
+        if (value.empty() || value.find_first_not_of("0123456789") != std::string::npos) {
+            throw std::runtime_error("Invalid response_cache (should be a number of entries, 0 to disable)");
+        }
+        server.response_cache = static_cast<size_t>(atol(value.c_str()));
+    } else if (key == "response_cache_max_size") {
+        server.response_cache_max_size = parseSize(value);
+    } else if (key == "gzip") {
+        server.gzip = (value == "on" || value == "true");
+    } else if (key == "gzip_comp_level") {
+        int level = atoi(value.c_str());
+        if (level < 1 || level > 9 || value.find_first_not_of("0123456789") != std::string::npos) {
+            throw std::runtime_error("Invalid gzip_comp_level (should be between 1 and 9)");
+        }
+        server.gzip_comp_level = level;
+    } else if (key == "gzip_min_length") {
+        server.gzip_min_length = parseSize(value);
     } else {
         throw std::runtime_error("Unknown server directive: " + key);
     }
@@ -207,6 +358,8 @@ void ConfigParser::processLocationDirective(const std::string& key, const std::s
         location.allowed_methods = split(value, ' ');
     } else if (key == "autoindex") {
         location.autoindex = (value == "on" || value == "true");
+    } else if (key == "gzip_static") {
+        location.gzip_static = (value == "on" || value == "true");
     } else if (key == "index") {
         location.index_files = split(value, ' ');
     } else if (key == "root") {
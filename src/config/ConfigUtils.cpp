@@ -57,6 +57,31 @@ size_t ConfigParser::parseSize(const std::string& size_str) {
     }
 }
 
+/**
+ * @brief Convertit une durée ("30", "30s", "500ms", "2m") en millisecondes
+ */
+unsigned long ConfigParser::parseTime(const std::string& time_str) {
+    size_t digits_end = time_str.find_first_not_of("0123456789");
+    if (time_str.empty() || digits_end == 0) {
+        throw std::runtime_error("Invalid time value: " + time_str);
+    }
+    
+    unsigned long value = static_cast<unsigned long>(atol(time_str.substr(0, digits_end).c_str()));
+    if (digits_end == std::string::npos) {
+        return value * 1000; // Secondes par défaut
+    }
+    
+    std::string unit = time_str.substr(digits_end);
+    if (unit == "ms") {
+        return value;
+    } else if (unit == "s") {
+        return value * 1000;
+    } else if (unit == "m") {
+        return value * 60 * 1000;
+    }
+    throw std::runtime_error("Invalid time unit: " + time_str);
+}
+
 bool ConfigParser::fileExists(const std::string& path) {
     std::ifstream file(path.c_str());
     return file.good();
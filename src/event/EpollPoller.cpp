@@ -0,0 +1,117 @@
+#include "event/EpollPoller.hpp"
+
+#ifdef WEBSERV_HAS_EPOLL
+
+# include "utils/Common.hpp"
+# include <cerrno>
+# include <cstring>
+
+# define EPOLL_MAX_EVENTS 1024 // Nombre maximum d'événements récupérés par epoll_wait()
+
+EpollPoller::EpollPoller()
+    : epoll_fd(-1)
+    , events_buffer(EPOLL_MAX_EVENTS) {
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd < 0) {
+        throw std::runtime_error("epoll_create1 failed: " + std::string(strerror(errno)));
+    }
+}
+
+EpollPoller::~EpollPoller() {
+    if (epoll_fd >= 0) {
+        close(epoll_fd);
+    }
+}
+
+unsigned int EpollPoller::toEpollEvents(int events) {
+    unsigned int epoll_events = 0;
+    if (events & EVENT_READ) {
+        epoll_events |= EPOLLIN;
+    }
+    if (events & EVENT_WRITE) {
+        epoll_events |= EPOLLOUT;
+    }
+    return epoll_events;
+}
+
+/**
+ * @brief Enregistre un fd auprès d'epoll ; le fd est placé dans epoll_data
+ * et la donnée utilisateur dans la table indexée par fd
+ */
+bool EpollPoller::add(int fd, int events, void* data) {
+    if (fd < 0 || data == NULL || isRegistered(fd)) {
+        return false;
+    }
+
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = toEpollEvents(events);
+    ev.data.fd = fd;
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+        LOG_ERROR("epoll_ctl(ADD) failed for fd " << fd << ": " << strerror(errno));
+        return false;
+    }
+    setData(fd, data, events);
+    return true;
+}
+
+bool EpollPoller::modify(int fd, int events, void* data) {
+    if (!isRegistered(fd)) {
+        return false;
+    }
+
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = toEpollEvents(events);
+    ev.data.fd = fd;
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_MOD, fd, &ev) < 0) {
+        LOG_ERROR("epoll_ctl(MOD) failed for fd " << fd << ": " << strerror(errno));
+        return false;
+    }
+    setData(fd, data, events);
+    return true;
+}
+
+void EpollPoller::remove(int fd) {
+    if (!isRegistered(fd)) {
+        return;
+    }
+    // Le fd peut déjà être fermé : l'erreur éventuelle est sans conséquence
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, NULL);
+    clearData(fd);
+}
+
+int EpollPoller::wait(std::vector<PollEvent>& ready, int timeout_ms) {
+    ready.clear();
+
+    int ret = epoll_wait(epoll_fd, &events_buffer[0], events_buffer.size(), timeout_ms);
+    if (ret <= 0) {
+        return ret;
+    }
+
+    for (int i = 0; i < ret; ++i) {
+        const struct epoll_event& ev = events_buffer[i];
+
+        PollEvent event;
+        event.fd = ev.data.fd;
+        event.events = 0;
+        if (ev.events & EPOLLIN) {
+            event.events |= EVENT_READ;
+        }
+        if (ev.events & EPOLLOUT) {
+            event.events |= EVENT_WRITE;
+        }
+        if (ev.events & (EPOLLERR | EPOLLHUP)) {
+            event.events |= EVENT_ERROR;
+        }
+        event.data = getData(event.fd);
+        if (event.data == NULL) {
+            continue; // fd retiré entre-temps
+        }
+        ready.push_back(event);
+    }
+
+    return static_cast<int>(ready.size());
+}
+
+#endif // WEBSERV_HAS_EPOLL
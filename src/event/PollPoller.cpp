@@ -0,0 +1,108 @@
+#include "event/PollPoller.hpp"
+#include <cerrno>
+
+PollPoller::PollPoller() {
+}
+
+PollPoller::~PollPoller() {
+}
+
+short PollPoller::toPollEvents(int events) {
+    short poll_events = 0;
+    if (events & EVENT_READ) {
+        poll_events |= POLLIN;
+    }
+    if (events & EVENT_WRITE) {
+        poll_events |= POLLOUT;
+    }
+    return poll_events;
+}
+
+/**
+ * @brief Ajoute un fd au tableau poll
+ */
+bool PollPoller::add(int fd, int events, void* data) {
+    if (fd < 0 || data == NULL || isRegistered(fd)) {
+        return false;
+    }
+
+    struct pollfd pfd;
+    pfd.fd = fd;
+    pfd.events = toPollEvents(events);
+    pfd.revents = 0;
+
+    if (static_cast<size_t>(fd) >= fd_index.size()) {
+        fd_index.resize(fd + 1, -1);
+    }
+    fd_index[fd] = static_cast<int>(poll_fds.size());
+    poll_fds.push_back(pfd);
+    setData(fd, data, events);
+    return true;
+}
+
+/**
+ * @brief Modifie les événements surveillés pour un fd
+ */
+bool PollPoller::modify(int fd, int events, void* data) {
+    if (!isRegistered(fd)) {
+        return false;
+    }
+    poll_fds[fd_index[fd]].events = toPollEvents(events);
+    setData(fd, data, events);
+    return true;
+}
+
+/**
+ * @brief Supprime un fd en déplaçant le dernier élément à sa place
+ */
+void PollPoller::remove(int fd) {
+    if (!isRegistered(fd)) {
+        return;
+    }
+
+    int index = fd_index[fd];
+    int last = static_cast<int>(poll_fds.size()) - 1;
+    if (index != last) {
+        poll_fds[index] = poll_fds[last];
+        fd_index[poll_fds[index].fd] = index;
+    }
+    poll_fds.pop_back();
+    fd_index[fd] = -1;
+    clearData(fd);
+}
+
+/**
+ * @brief Appelle poll() puis ne renvoie que les descripteurs ayant des revents
+ */
+int PollPoller::wait(std::vector<PollEvent>& ready, int timeout_ms) {
+    ready.clear();
+
+    int ret = poll(poll_fds.empty() ? NULL : &poll_fds[0], poll_fds.size(), timeout_ms);
+    if (ret <= 0) {
+        return ret;
+    }
+
+    for (size_t i = 0; i < poll_fds.size() && static_cast<int>(ready.size()) < ret; ++i) {
+        short revents = poll_fds[i].revents;
+        if (revents == 0) {
+            continue;
+        }
+
+        PollEvent event;
+        event.fd = poll_fds[i].fd;
+        event.events = 0;
+        if (revents & POLLIN) {
+            event.events |= EVENT_READ;
+        }
+        if (revents & POLLOUT) {
+            event.events |= EVENT_WRITE;
+        }
+        if (revents & (POLLERR | POLLHUP | POLLNVAL)) {
+            event.events |= EVENT_ERROR;
+        }
+        event.data = getData(event.fd);
+        ready.push_back(event);
+    }
+
+    return static_cast<int>(ready.size());
+}
@@ -0,0 +1,64 @@
+#include "event/Poller.hpp"
+#include "event/PollPoller.hpp"
+#include "event/EpollPoller.hpp"
+#include "utils/Common.hpp"
+
+/**
+ * @brief Crée le backend de multiplexage demandé
+ * @param backend "epoll", "poll" ou chaîne vide pour le choix automatique
+ * @return Une instance allouée avec new (à libérer par l'appelant)
+ */
+Poller* Poller::create(const std::string& backend) {
+#ifdef WEBSERV_HAS_EPOLL
+    if (backend.empty() || backend == "epoll") {
+        return new EpollPoller();
+    }
+#else
+    if (backend == "epoll") {
+        LOG_WARNING("epoll backend not available in this build, falling back to poll");
+    }
+#endif
+    return new PollPoller();
+}
+
+/**
+ * @brief Récupère la donnée utilisateur associée à un fd
+ * @return Le pointeur enregistré, ou NULL si le fd n'est pas surveillé
+ */
+void* Poller::getData(int fd) const {
+    if (fd < 0 || static_cast<size_t>(fd) >= fd_data.size()) {
+        return NULL;
+    }
+    return fd_data[fd];
+}
+
+/**
+ * @brief Événements actuellement surveillés pour un fd (0 si non enregistré)
+ */
+int Poller::getEvents(int fd) const {
+    if (getData(fd) == NULL) {
+        return 0;
+    }
+    return fd_events[fd];
+}
+
+void Poller::setData(int fd, void* data, int events) {
+    if (static_cast<size_t>(fd) >= fd_data.size()) {
+        fd_data.resize(fd + 1, NULL);
+        fd_events.resize(fd + 1, 0);
+    }
+    if (fd_data[fd] == NULL) {
+        registered++;
+    }
+    fd_data[fd] = data;
+    fd_events[fd] = events;
+}
+
+void Poller::clearData(int fd) {
+    if (fd < 0 || static_cast<size_t>(fd) >= fd_data.size() || fd_data[fd] == NULL) {
+        return;
+    }
+    fd_data[fd] = NULL;
+    fd_events[fd] = 0;
+    registered--;
+}
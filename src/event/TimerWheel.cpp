@@ -0,0 +1,205 @@
+#include "event/TimerWheel.hpp"
+#include <time.h>
+
+/**
+ * @brief Constructeur
+ * @param tick_ms Résolution de la roue en millisecondes
+ */
+TimerWheel::TimerWheel(unsigned long tick_ms)
+    : tick_ms(tick_ms > 0 ? tick_ms : 1)
+    , current_tick(0)
+    , origin_ms(nowMs())
+    , count(0) {
+    for (int i = 0; i < SLOT_COUNT; i++) {
+        heads[i] = -1;
+    }
+}
+
+/**
+ * @brief Horloge monotone en millisecondes (insensible aux changements d'heure)
+ */
+unsigned long TimerWheel::nowMs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<unsigned long>(ts.tv_sec) * 1000UL + ts.tv_nsec / 1000000;
+}
+
+unsigned long TimerWheel::tickFor(unsigned long ms) const {
+    return (ms - origin_ms) / tick_ms;
+}
+
+/**
+ * @brief Chaîne un nœud dans le slot correspondant à son échéance
+ */
+void TimerWheel::link(int fd) {
+    Node& node = nodes[fd];
+    if (node.expires < current_tick) {
+        node.expires = current_tick;
+    }
+
+    unsigned long delta = node.expires - current_tick;
+    int slot;
+    if (delta < ROOT_SIZE) {
+        slot = node.expires & (ROOT_SIZE - 1);
+    } else {
+        int level = 0;
+        unsigned long shift = ROOT_BITS;
+        while (level < LEVELS - 1 && delta >= (1UL << (shift + LEVEL_BITS))) {
+            level++;
+            shift += LEVEL_BITS;
+        }
+        // Au-delà du dernier niveau, l'échéance est ramenée au maximum représentable
+        if (delta >= (1UL << (shift + LEVEL_BITS))) {
+            node.expires = current_tick + (1UL << (shift + LEVEL_BITS)) - 1;
+        }
+        slot = ROOT_SIZE + level * LEVEL_SIZE + ((node.expires >> shift) & (LEVEL_SIZE - 1));
+    }
+
+    node.slot = slot;
+    node.prev = -1;
+    node.next = heads[slot];
+    if (heads[slot] >= 0) {
+        nodes[heads[slot]].prev = fd;
+    }
+    heads[slot] = fd;
+}
+
+/**
+ * @brief Retire un nœud de son slot
+ */
+void TimerWheel::unlink(int fd) {
+    Node& node = nodes[fd];
+    if (node.prev >= 0) {
+        nodes[node.prev].next = node.next;
+    } else {
+        heads[node.slot] = node.next;
+    }
+    if (node.next >= 0) {
+        nodes[node.next].prev = node.prev;
+    }
+    node.prev = -1;
+    node.next = -1;
+    node.slot = -1;
+}
+
+/**
+ * @brief Arme (ou réarme) le timer d'un fd
+ */
+void TimerWheel::schedule(int fd, unsigned long timeout_ms) {
+    if (fd < 0) {
+        return;
+    }
+    if (static_cast<size_t>(fd) >= nodes.size()) {
+        nodes.resize(fd + 1);
+    }
+
+    if (nodes[fd].slot >= 0) {
+        unlink(fd);
+    } else {
+        count++;
+    }
+
+    unsigned long ticks = (timeout_ms + tick_ms - 1) / tick_ms;
+    nodes[fd].expires = tickFor(nowMs()) + (ticks > 0 ? ticks : 1);
+    link(fd);
+}
+
+/**
+ * @brief Désarme le timer d'un fd
+ */
+void TimerWheel::cancel(int fd) {
+    if (!isScheduled(fd)) {
+        return;
+    }
+    unlink(fd);
+    count--;
+}
+
+bool TimerWheel::isScheduled(int fd) const {
+    return fd >= 0 && static_cast<size_t>(fd) < nodes.size() && nodes[fd].slot >= 0;
+}
+
+/**
+ * @brief Redistribue les timers d'un slot de niveau supérieur vers les niveaux inférieurs
+ */
+void TimerWheel::cascade(int level, unsigned long index) {
+    int slot = ROOT_SIZE + level * LEVEL_SIZE + static_cast<int>(index);
+    int fd = heads[slot];
+    heads[slot] = -1;
+
+    while (fd >= 0) {
+        int next = nodes[fd].next;
+        nodes[fd].prev = -1;
+        nodes[fd].next = -1;
+        link(fd);
+        fd = next;
+    }
+}
+
+/**
+ * @brief Fait avancer la roue tick par tick jusqu'à l'instant présent
+ */
+void TimerWheel::advance(std::vector<int>& expired) {
+    expired.clear();
+    unsigned long target = tickFor(nowMs());
+
+    if (count == 0) {
+        current_tick = target; // Rien à expirer : inutile de parcourir les ticks
+        return;
+    }
+
+    while (current_tick < target) {
+        unsigned long tick = ++current_tick;
+
+        // Tour complet de la racine : faire descendre le slot suivant du niveau 1, etc.
+        // Les timers redistribués échoient au plus tôt sur ce tick, traité juste après
+        if ((tick & (ROOT_SIZE - 1)) == 0) {
+            unsigned long shift = ROOT_BITS;
+            for (int level = 0; level < LEVELS; level++) {
+                unsigned long index = (tick >> shift) & (LEVEL_SIZE - 1);
+                cascade(level, index);
+                if (index != 0) {
+                    break;
+                }
+                shift += LEVEL_BITS;
+            }
+        }
+
+        // Tous les nœuds du slot racine courant expirent maintenant
+        int slot = tick & (ROOT_SIZE - 1);
+        int fd = heads[slot];
+        while (fd >= 0) {
+            int next = nodes[fd].next;
+            unlink(fd);
+            count--;
+            expired.push_back(fd);
+            fd = next;
+        }
+
+        if (count == 0) {
+            current_tick = target;
+        }
+    }
+}
+
+/**
+ * @brief Délai jusqu'au prochain slot non vide (borné à un tour de la racine)
+ * @return Le délai en ms, ou -1 si aucun timer n'est armé
+ */
+int TimerWheel::nextTimeout() const {
+    if (count == 0) {
+        return -1;
+    }
+
+    unsigned long ticks = ROOT_SIZE - (current_tick & (ROOT_SIZE - 1)); // Prochaine cascade
+    for (unsigned long i = 1; i < ticks; i++) {
+        if (heads[(current_tick + i) & (ROOT_SIZE - 1)] >= 0) {
+            ticks = i;
+            break;
+        }
+    }
+
+    unsigned long deadline = origin_ms + (current_tick + ticks) * tick_ms;
+    unsigned long now = nowMs();
+    return deadline > now ? static_cast<int>(deadline - now) : 0;
+}
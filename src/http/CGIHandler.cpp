@@ -13,6 +13,7 @@
 #include <fcntl.h>
 #include <limits.h>  // Pour PATH_MAX
 #include <cerrno>
+#include <algorithm>
 #include <sys/time.h>
 #include <sys/types.h>
 #include <signal.h>
@@ -263,18 +264,18 @@ std::vector<std::string> CGIHandler::prepareEnvironment() const {
     env.push_back("REMOTE_ADDR=127.0.0.1");
     env.push_back("PATH=/usr/local/bin:/usr/bin:/bin");
     
-    const std::map<std::string, std::string>& headers = request_.getHeaders();
-    for (std::map<std::string, std::string>::const_iterator it = headers.begin(); it != headers.end(); ++it) {
-        std::string header_name = it->first;
+    const HttpHeaders& headers = request_.getHeaders();
+    for (size_t i = 0; i < headers.size(); i++) {
+        std::string header_name = headers[i].name;
         std::transform(header_name.begin(), header_name.end(), header_name.begin(), ::toupper);
         std::string env_name = "HTTP_" + header_name;
         std::replace(env_name.begin(), env_name.end(), '-', '_');
-        env.push_back(env_name + "=" + it->second);
+        env.push_back(env_name + "=" + headers[i].value);
     }
 
     if (request_.getMethod() == "POST") {
-        std::string contentLength = request_.getHeader("Content-Length");
-        std::string contentType = request_.getHeader("Content-Type");
+        const std::string& contentLength = request_.getHeader(HEADER_CONTENT_LENGTH);
+        const std::string& contentType = request_.getHeader(HEADER_CONTENT_TYPE);
         
         if (!contentLength.empty()) {
             env.push_back("CONTENT_LENGTH=" + contentLength);
@@ -28,7 +28,7 @@ void CookieSessionManager::setSessionCookie(HttpResponse& response, const std::s
 }
 
 bool CookieSessionManager::hasValidSessionCookie(const HttpRequest& request) {
-    std::string session_cookie_header = request.getHeader("Cookie");
+    const std::string& session_cookie_header = request.getHeader(HEADER_COOKIE);
     std::string search_str = std::string(SECRET_CODE_NAME) + "=";
     size_t start_pos = session_cookie_header.find(search_str);
 
@@ -67,7 +67,7 @@ bool CookieSessionManager::hasValidSessionCookie(const HttpRequest& request) {
 }
 
 std::string CookieSessionManager::getSessionId(const HttpRequest& request) {
-    std::string session_cookie = request.getHeader("Cookie");
+    const std::string& session_cookie = request.getHeader(HEADER_COOKIE);
     std::string session_id = "";
     std::string search_str = std::string(SECRET_CODE_NAME) + "=";
     size_t start_pos = session_cookie.find(search_str);
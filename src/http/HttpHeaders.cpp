@@ -0,0 +1,123 @@
+#include "http/HttpHeaders.hpp"
+#include <cctype>
+
+namespace {
+
+struct KnownHeader {
+    const char* name;  // En minuscules
+    size_t length;
+    HttpHeaderId id;
+};
+
+const KnownHeader KNOWN_HEADERS[] = {
+    { "host",              4,  HEADER_HOST },
+    { "connection",        10, HEADER_CONNECTION },
+    { "content-length",    14, HEADER_CONTENT_LENGTH },
+    { "content-type",      12, HEADER_CONTENT_TYPE },
+    { "transfer-encoding", 17, HEADER_TRANSFER_ENCODING },
+    { "expect",            6,  HEADER_EXPECT },
+    { "cookie",            6,  HEADER_COOKIE },
+    { "if-none-match",     13, HEADER_IF_NONE_MATCH },
+    { "if-modified-since", 17, HEADER_IF_MODIFIED_SINCE },
+    { "if-range",          8,  HEADER_IF_RANGE },
+    { "range",             5,  HEADER_RANGE },
+    { "accept",            6,  HEADER_ACCEPT },
+    { "accept-encoding",   15, HEADER_ACCEPT_ENCODING },
+    { "user-agent",        10, HEADER_USER_AGENT },
+    { "referer",           7,  HEADER_REFERER },
+    { "authorization",     13, HEADER_AUTHORIZATION }
+};
+
+const size_t KNOWN_HEADER_COUNT = sizeof(KNOWN_HEADERS) / sizeof(KNOWN_HEADERS[0]);
+
+// Compare un nom quelconque à un nom en minuscules
+bool equalsLower(const char* name, const char* lower, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        if (tolower(static_cast<unsigned char>(name[i])) != lower[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+HttpHeaders::HttpHeaders() {
+    for (int i = 0; i < HEADER_COUNT; i++) {
+        known[i] = -1;
+    }
+}
+
+/**
+ * @brief Identifiant d'un nom d'en-tête, comparé sans tenir compte de la casse
+ */
+HttpHeaderId HttpHeaders::lookupId(const char* name, size_t name_len) {
+    for (size_t i = 0; i < KNOWN_HEADER_COUNT; i++) {
+        if (KNOWN_HEADERS[i].length == name_len && equalsLower(name, KNOWN_HEADERS[i].name, name_len)) {
+            return KNOWN_HEADERS[i].id;
+        }
+    }
+    return HEADER_OTHER;
+}
+
+void HttpHeaders::set(const char* name, size_t name_len, const char* value, size_t value_len) {
+    HttpHeaderId id = lookupId(name, name_len);
+
+    // Une occurrence existante est remplacée (la dernière l'emporte)
+    Entry* entry = NULL;
+    if (id != HEADER_OTHER) {
+        if (known[id] >= 0) {
+            entry = &entries[known[id]];
+        }
+    } else {
+        for (size_t i = 0; i < entries.size() && !entry; i++) {
+            if (entries[i].id == HEADER_OTHER && entries[i].name.size() == name_len
+                && equalsLower(name, entries[i].name.data(), name_len)) {
+                entry = &entries[i];
+            }
+        }
+    }
+
+    if (!entry) {
+        entries.push_back(Entry());
+        entry = &entries.back();
+        entry->id = id;
+        entry->name.resize(name_len);
+        for (size_t i = 0; i < name_len; i++) {
+            entry->name[i] = static_cast<char>(tolower(static_cast<unsigned char>(name[i])));
+        }
+        if (id != HEADER_OTHER) {
+            known[id] = static_cast<int>(entries.size() - 1);
+        }
+    }
+    entry->value.assign(value, value_len);
+}
+
+void HttpHeaders::clear() {
+    entries.clear();
+    for (int i = 0; i < HEADER_COUNT; i++) {
+        known[i] = -1;
+    }
+}
+
+const std::string* HttpHeaders::find(HttpHeaderId id) const {
+    if (id < 0 || id >= HEADER_COUNT || known[id] < 0) {
+        return NULL;
+    }
+    return &entries[known[id]].value;
+}
+
+const std::string* HttpHeaders::find(const char* name, size_t name_len) const {
+    HttpHeaderId id = lookupId(name, name_len);
+    if (id != HEADER_OTHER) {
+        return find(id);
+    }
+
+    for (size_t i = 0; i < entries.size(); i++) {
+        if (entries[i].id == HEADER_OTHER && entries[i].name.size() == name_len
+            && equalsLower(name, entries[i].name.data(), name_len)) {
+            return &entries[i].value;
+        }
+    }
+    return NULL;
+}
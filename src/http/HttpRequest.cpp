@@ -1,9 +1,8 @@
 #include "http/HttpRequest.hpp"
 #include "http/parser/FormParser.hpp"
+#include "http/parser/ChunkedDecoder.hpp"
 #include "http/utils/HttpUtils.hpp"
 #include "utils/Common.hpp"
-#include <sstream>
-#include <algorithm>
 
 HttpRequest::HttpRequest() : max_body_size(DEFAULT_MAX_BODY_SIZE), error_code(0), error_message("") {}
 
@@ -21,45 +20,91 @@ void HttpRequest::clear() {
     error_message = "";
 }
 
+/**
+ * @brief Parse une requête complète contenue dans une chaîne
+ * 
+ * Sans Content-Length, tout ce qui suit les en-têtes est considéré comme le body.
+ * Un body chunked est décodé ici en une fois.
+ */
 bool HttpRequest::parse(const std::string& raw_request) {
-    clear();
-    
-    // Trouver la fin de la première ligne
-    size_t pos = raw_request.find("\r\n");
-    if (pos == std::string::npos) {
-        LOG_ERROR("Invalid request: no CRLF found");
+    RequestParser parser;
+    if (parser.feed(raw_request.data(), raw_request.size()) == RequestParser::PARSE_ERROR) {
+        clear();
+        LOG_ERROR("Invalid request line or headers");
+        error_code = parser.getErrorCode();
         return false;
     }
-    
-    // Parser la première ligne (méthode, URI, version)
-    if (!parseRequestLine(raw_request.substr(0, pos))) {
+    if (!parser.headersComplete()) {
+        clear();
+        LOG_ERROR("Invalid request: no empty line before body");
         return false;
     }
+    if (parser.isChunked()) {
+        ChunkedDecoder decoder;
+        decoder.setMaxBodySize(max_body_size);
+        std::string decoded;
+        size_t consumed = 0;
+        size_t start = parser.getHeadersEnd();
+        if (decoder.decode(raw_request.data() + start, raw_request.size() - start, consumed, decoded)
+                != ChunkedDecoder::DECODE_DONE) {
+            clear();
+            LOG_ERROR("Invalid chunked body");
+            error_code = decoder.getErrorCode() ? decoder.getErrorCode() : 400;
+            return false;
+        }
+        return parse(raw_request.data(), start, parser, &decoded);
+    }
+    return parse(raw_request.data(), raw_request.size(), parser);
+}
+
+/**
+ * @brief Construit la requête à partir des positions relevées par le RequestParser
+ * 
+ * Seules les valeurs exposées par l'API sont copiées, une seule fois chacune,
+ * directement depuis le tampon de réception. Un body chunked, décodé hors du
+ * tampon, est repris par échange avec decoded_body.
+ */
+bool HttpRequest::parse(const char* data, size_t size, const RequestParser& parser, std::string* decoded_body) {
+    clear();
     
-    // Parser les headers
-    size_t body_start = raw_request.find("\r\n\r\n");
-    if (body_start == std::string::npos) {
-        LOG_ERROR("Invalid request: no empty line before body");
-        return false;
+    method.assign(data + parser.getMethod().offset, parser.getMethod().length);
+    uri.assign(data + parser.getTarget().offset, parser.getTarget().length);
+    version.assign(data + parser.getVersion().offset, parser.getVersion().length);
+    
+    // En-têtes : nom en minuscules, la dernière occurrence l'emporte
+    const std::vector<HeaderSpan>& spans = parser.getHeaders();
+    for (size_t i = 0; i < spans.size(); i++) {
+        headers.set(data + spans[i].name.offset, spans[i].name.length,
+                    data + spans[i].value.offset, spans[i].value.length);
     }
     
-    // Extraire et parser les headers
-    std::string headers_section = raw_request.substr(pos + 2, body_start - pos - 2);
-    if (!parseHeaders(headers_section)) {
-        return false;
+    // Body chunked : déjà décodé et limité à max_body_size pendant la réception
+    if (decoded_body) {
+        if (decoded_body->size() > max_body_size) {
+            LOG_ERROR("Request body too large: " << decoded_body->size() << " bytes (max: " << max_body_size << ")");
+            error_code = 413;
+            error_message = "Payload Too Large";
+            return false;
+        }
+        body.swap(*decoded_body);
+        size = parser.getHeadersEnd();
     }
     
-    // Extraire le body s'il existe
-    if (body_start + 4 < raw_request.length()) {
-        body = raw_request.substr(body_start + 4);
-        
+    // Body : Content-Length octets, ou le reste du tampon à défaut
+    size_t body_start = parser.getHeadersEnd();
+    size_t body_end = size;
+    if (parser.hasContentLength() && body_start + parser.getContentLength() < size) {
+        body_end = body_start + parser.getContentLength();
+    }
+    if (body_end > body_start) {
         // Vérifier la taille du body
-        if (body.length() > max_body_size) {
-            LOG_ERROR("Request body too large: " << body.length() << " bytes (max: " << max_body_size << ")");
+        if (body_end - body_start > max_body_size) {
+            LOG_ERROR("Request body too large: " << body_end - body_start << " bytes (max: " << max_body_size << ")");
             error_code = 413;  // Définir le code d'erreur payload too large
             error_message = "Payload Too Large";
             return false;
         }
+        body.assign(data + body_start, body_end - body_start);
     }
     
     // Parser l'URI pour extraire la query string
@@ -73,86 +118,25 @@ bool HttpRequest::parse(const std::string& raw_request) {
     return true;
 }
 
-bool HttpRequest::parseRequestLine(const std::string& line) {
-    std::istringstream iss(line);
-    
-    // Extraire la méthode
-    if (!(iss >> method)) {
-        LOG_ERROR("Failed to parse HTTP method");
-        return false;
-    }
-    
-    // Extraire l'URI
-    if (!(iss >> uri)) {
-        LOG_ERROR("Failed to parse URI");
-        return false;
-    }
-    
-    // Extraire la version HTTP
-    if (!(iss >> version)) {
-        LOG_ERROR("Failed to parse HTTP version");
-        return false;
-    }
-    
-    // Vérifier la version HTTP
-    if (version != "HTTP/1.1" && version != "HTTP/1.0") {
-        LOG_ERROR("Unsupported HTTP version: " << version);
-        return false;
-    }
-    
-    return true;
-}
-
-bool HttpRequest::parseHeaders(const std::string& headers_section) {
-    std::istringstream iss(headers_section);
-    std::string line;
-    
-    while (std::getline(iss, line)) {
-        // Supprimer le \r à la fin de la ligne
-        if (!line.empty() && line[line.length() - 1] == '\r') {
-            line.erase(line.length() - 1);
-        }
-        
-        // Ignorer les lignes vides
-        if (line.empty()) {
-            continue;
-        }
-        
-        // Trouver le séparateur ': '
-        size_t colon = line.find(": ");
-        if (colon == std::string::npos) {
-            LOG_ERROR("Invalid header format: " << line);
-            return false;
-        }
-        
-        // Extraire le nom et la valeur
-        std::string name = line.substr(0, colon);
-        std::string value = line.substr(colon + 2);
-        
-        // Convertir le nom en minuscules
-        std::transform(name.begin(), name.end(), name.begin(), ::tolower);
-        
-        // Ajouter le header
-        headers[name] = value;
-    }
-    
-    return true;
-}
-
 void HttpRequest::parseQueryString() {
     size_t query_pos = uri.find('?');
     if (query_pos != std::string::npos) {
-        query_string = uri.substr(query_pos + 1);
-        uri = uri.substr(0, query_pos);
+        query_string.assign(uri, query_pos + 1, std::string::npos);
+        uri.erase(query_pos);
     }
 }
 
+const std::string& HttpRequest::headerOrEmpty(const std::string* value) {
+    static const std::string empty;
+    return value ? *value : empty;
+}
+
 void HttpRequest::parseFormBody() {
-    std::map<std::string, std::string>::const_iterator it = headers.find("content-type");
-    if (it == headers.end())
+    const std::string* content_type_value = headers.find(HEADER_CONTENT_TYPE);
+    if (!content_type_value)
         return;
     
-    const std::string& content_type = it->second;
+    const std::string& content_type = *content_type_value;
     
     if (content_type.find("application/x-www-form-urlencoded") != std::string::npos) {
         FormParser::parseUrlEncoded(body, form_data);
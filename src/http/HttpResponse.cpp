@@ -1,6 +1,8 @@
 #include "http/HttpResponse.hpp"
 #include "http/HttpRequest.hpp"
 #include "http/utils/HttpStringUtils.hpp"
+#include "http/utils/HttpDate.hpp"
+#include "http/utils/MimeTypes.hpp"
 #include <fstream>
 #include <sstream>
 #include <sys/stat.h>
@@ -33,7 +35,7 @@ static std::string numberToString(T value) {
  * Initialise une réponse HTTP avec un code 200 (OK)
  * et définit les en-têtes de base.
  */
-HttpResponse::HttpResponse() : status_code(200), status_message("OK") {
+HttpResponse::HttpResponse() : status_code(200), status_message("OK"), file_offset(0), file_length(0) {
     setHeader("Server", "webserv/1.0");
     setHeader("Connection", "keep-alive");
 }
@@ -84,7 +86,10 @@ void HttpResponse::setStatus(int code, const std::string& message) {
             case 413: status_message = "Payload Too Large"; break;
             case 414: status_message = "URI Too Long"; break;
             case 415: status_message = "Unsupported Media Type"; break;
+            case 416: status_message = "Range Not Satisfiable"; break;
+            case 417: status_message = "Expectation Failed"; break;
             case 429: status_message = "Too Many Requests"; break;
+            case 431: status_message = "Request Header Fields Too Large"; break;
             case 500: status_message = "Internal Server Error"; break;
             case 501: status_message = "Not Implemented"; break;
             case 502: status_message = "Bad Gateway"; break;
@@ -113,10 +118,95 @@ void HttpResponse::setHeader(const std::string& key, const std::string& value) {
  */
 void HttpResponse::setBody(const std::string& content, const std::string& content_type) {
     body = content;
+    file_body.reset();
+    file_parts.clear();
+    prebuilt.reset();
+    shared_body.reset();
     setHeader("Content-Type", content_type);
     setHeader("Content-Length", numberToString(body.size()));
 }
 
+/**
+ * @brief Définit un body déjà en mémoire et partagé (page d'erreur préchargée,
+ *        fichier compressé du cache gzip)
+ * @param content Le contenu, référencé sans copie
+ * @param content_type Le type MIME du contenu
+ * 
+ * Le serveur met le tampon tel quel dans la file d'envoi, après les en-têtes.
+ */
+void HttpResponse::setBody(const SharedBuffer& content, const std::string& content_type) {
+    body.clear();
+    file_body.reset();
+    file_parts.clear();
+    prebuilt.reset();
+    shared_body = content;
+    setHeader("Content-Type", content_type);
+    setHeader("Content-Length", numberToString(content.size()));
+}
+
+/**
+ * @brief Définit un body lu directement dans un fichier ouvert
+ * @param file Fichier ouvert (partagé : la réponse en garde une référence)
+ * @param offset Position du premier octet à envoyer
+ * @param length Nombre d'octets à envoyer
+ * @param content_type Le type MIME du contenu
+ * 
+ * Le contenu n'est pas chargé en mémoire : le serveur l'envoie par
+ * sendfile(), par tranches, au rythme du socket.
+ */
+void HttpResponse::setFileBody(const FileHandle& file, off_t offset, size_t length, const std::string& content_type) {
+    body.clear();
+    prebuilt.reset();
+    shared_body.reset();
+    file_parts.clear();
+    file_body = file;
+    file_offset = offset;
+    file_length = length;
+    setHeader("Content-Type", content_type);
+    setHeader("Content-Length", numberToString(length));
+}
+
+/**
+ * @brief Définit un body multipart dont les parties sont des portions d'un fichier ouvert
+ * @param file Fichier ouvert (partagé : la réponse en garde une référence)
+ * @param parts En-têtes de chaque partie et portion du fichier qui la suit
+ * @param content_type Le type du body ("multipart/byteranges; boundary=...")
+ * 
+ * Seuls les en-têtes des parties sont en mémoire : chaque portion est
+ * envoyée par sendfile() depuis sa position, comme un body fichier simple.
+ */
+void HttpResponse::setFileParts(const FileHandle& file, const std::vector<FilePart>& parts,
+                                const std::string& content_type) {
+    body.clear();
+    prebuilt.reset();
+    shared_body.reset();
+    file_body = file;
+    file_parts = parts;
+    file_offset = 0;
+    file_length = 0;
+    size_t total = 0;
+    for (size_t i = 0; i < parts.size(); i++) {
+        file_length += parts[i].length;
+        total += parts[i].head.size() + parts[i].length;
+    }
+    setHeader("Content-Type", content_type);
+    setHeader("Content-Length", numberToString(total));
+}
+
+/**
+ * @brief Remplace la réponse par une réponse complète déjà sérialisée
+ * @param code Code de statut de la réponse préconstruite (pour la journalisation)
+ * @param raw Ligne de statut, en-têtes et body, partagés sans copie
+ */
+void HttpResponse::setPrebuilt(int code, const SharedBuffer& raw) {
+    setStatus(code);
+    body.clear();
+    file_body.reset();
+    file_parts.clear();
+    shared_body.reset();
+    prebuilt = raw;
+}
+
 /**
  * @brief Configure une réponse 304 Not Modified
  * @param etag La valeur de l'ETag pour la validation du cache
@@ -127,6 +217,10 @@ void HttpResponse::setBody(const std::string& content, const std::string& conten
 void HttpResponse::setNotModified(const std::string& etag) {
     setStatus(304);
     body.clear();
+    file_body.reset();
+    file_parts.clear();
+    prebuilt.reset();
+    shared_body.reset();
     setHeader("ETag", etag);
     setHeader("Content-Length", "0");
 }
@@ -183,33 +277,124 @@ void HttpResponse::enableCORS(const std::string& origin,
 }
 
 /**
- * @brief Construit la réponse HTTP complète
- * @return La chaîne de caractères représentant la réponse HTTP
+ * @brief Sérialise la ligne de statut et l'en-tête Date
+ * @param out Tampon auquel les lignes sont ajoutées
  * 
- * Génère la réponse HTTP complète, incluant la ligne de statut,
- * les en-têtes et le body.
+ * La date vient de l'horloge HttpDate, mise à jour par la boucle
+ * d'événements : rien n'est formaté ici. Ces lignes précèdent aussi les
+ * réponses préconstruites, qui n'en contiennent pas.
  */
-std::string HttpResponse::build() const {
-    std::stringstream response;
-    
-    // Ligne de statut
-    response << "HTTP/1.1 " << status_code << " " << status_message << "\r\n";
-    
-    // Headers
+void HttpResponse::serializeStatusLine(std::string& out) const {
+    out.append("HTTP/1.1 ");
+    out.append(numberToString(status_code));
+    out.push_back(' ');
+    out.append(status_message);
+    out.append("\r\n");
+    if (headers.find("Date") == headers.end()) { // Un script CGI peut fournir la sienne
+        out.append("Date: ");
+        out.append(HttpDate::now());
+        out.append("\r\n");
+    }
+}
+
+/**
+ * @brief Sérialise les en-têtes de l'objet et la ligne vide qui les termine
+ */
+void HttpResponse::serializeFields(std::string& out) const {
     std::map<std::string, std::string>::const_iterator it;
     for (it = headers.begin(); it != headers.end(); ++it) {
-        response << it->first << ": " << it->second << "\r\n";
+        out.append(it->first);
+        out.append(": ");
+        out.append(it->second);
+        out.append("\r\n");
     }
     
     // Séparation headers/body
-    response << "\r\n";
-    
-    // Body
-    if (!body.empty()) {
-        response << body;
+    out.append("\r\n");
+}
+
+/**
+ * @brief Sérialise la ligne de statut et les en-têtes
+ * @param out Tampon auquel les en-têtes sont ajoutés (sa capacité peut être réutilisée)
+ * 
+ * Le body n'est pas inclus : il est envoyé à part, sans être recopié
+ * derrière les en-têtes.
+ */
+void HttpResponse::serializeHeaders(std::string& out) const {
+    serializeStatusLine(out);
+    serializeFields(out);
+}
+
+/**
+ * @brief Ajoute à out une portion de fichier lue par pread()
+ */
+static void appendFileRange(std::string& out, int fd, off_t offset, size_t length) {
+    size_t start = out.size();
+    out.resize(start + length);
+    size_t done = 0;
+    while (done < length) {
+        ssize_t n = pread(fd, &out[start + done], length - done, offset + done);
+        if (n <= 0) {
+            break; // Fichier tronqué depuis l'ouverture
+        }
+        done += n;
+    }
+    out.resize(start + done);
+}
+
+/**
+ * @brief Construit la réponse HTTP complète
+ * @return La chaîne de caractères représentant la réponse HTTP
+ * 
+ * Génère la réponse HTTP complète, incluant la ligne de statut,
+ * les en-têtes et le body. Le chemin d'envoi du serveur n'en a pas besoin
+ * (serializeHeaders() + takeBody()) ; elle reste pour les outils. Un body
+ * fichier est alors lu en mémoire.
+ */
+std::string HttpResponse::build() const {
+    std::string response;
+    serializeStatusLine(response);
+    if (hasPrebuilt()) {
+        response.append(prebuilt.data(), prebuilt.size());
+        return response;
+    }
+    appendFieldsAndBody(response);
+    return response;
+}
+
+/**
+ * @brief Construit une réponse à garder en cache pour setPrebuilt()
+ * 
+ * Ni ligne de statut ni Date : elles sont ajoutées à chaque envoi, la date
+ * d'une réponse en cache reste ainsi celle de l'envoi.
+ */
+std::string HttpResponse::buildPrebuilt() const {
+    std::string response;
+    appendFieldsAndBody(response);
+    return response;
+}
+
+/**
+ * @brief Ajoute à out les en-têtes de l'objet et le body (lu par pread() pour un fichier)
+ */
+void HttpResponse::appendFieldsAndBody(std::string& out) const {
+    serializeFields(out);
+    if (hasSharedBody()) {
+        out.append(shared_body.data(), shared_body.size());
+        return;
+    }
+    if (!hasFileBody()) {
+        out.append(body);
+        return;
+    }
+    if (file_parts.empty()) {
+        appendFileRange(out, file_body.fd(), file_offset, file_length);
+        return;
+    }
+    for (size_t i = 0; i < file_parts.size(); i++) {
+        out.append(file_parts[i].head);
+        appendFileRange(out, file_body.fd(), file_parts[i].offset, file_parts[i].length);
     }
-    
-    return response.str();
 }
 
 /**
@@ -220,21 +405,9 @@ std::string HttpResponse::build() const {
  * Utilisé pour répondre aux requêtes HEAD.
  */
 std::string HttpResponse::buildHeadResponse() const {
-    std::stringstream response;
-    
-    // Ligne de statut
-    response << "HTTP/1.1 " << status_code << " " << status_message << "\r\n";
-    
-    // Headers
-    std::map<std::string, std::string>::const_iterator it;
-    for (it = headers.begin(); it != headers.end(); ++it) {
-        response << it->first << ": " << it->second << "\r\n";
-    }
-    
-    // Séparation headers/body sans inclure le body
-    response << "\r\n";
-    
-    return response.str();
+    std::string response;
+    serializeHeaders(response);
+    return response;
 }
 
 /**
@@ -267,71 +440,8 @@ HttpResponse HttpResponse::createError(int error_code, const std::string& messag
  * Analyse l'extension du fichier pour déterminer son type MIME.
  * Retourne "application/octet-stream" si le type est inconnu.
  */
-std::string getMimeType(const std::string& file_path) {
-    static std::map<std::string, std::string> mime_types;
-    
-    // Initialisation si nécessaire (première fois seulement)
-    if (mime_types.empty()) {
-        // Types texte - affichés dans le navigateur
-        mime_types[".html"] = "text/html";
-        mime_types[".htm"] = "text/html";
-        mime_types[".css"] = "text/css";
-        mime_types[".txt"] = "text/plain";
-        mime_types[".md"] = "text/plain";
-        mime_types[".conf"] = "text/plain";
-        mime_types[".csv"] = "text/plain";
-        mime_types[".log"] = "text/plain";
-        
-        // Applications qui s'affichent dans le navigateur
-        mime_types[".json"] = "application/json";
-        mime_types[".xml"] = "application/xml";
-        mime_types[".js"] = "application/javascript";
-        
-        // Images - généralement affichées dans le navigateur
-        mime_types[".jpg"] = "image/jpeg";
-        mime_types[".jpeg"] = "image/jpeg";
-        mime_types[".png"] = "image/png";
-        mime_types[".gif"] = "image/gif";
-        mime_types[".svg"] = "image/svg+xml";
-        mime_types[".ico"] = "image/x-icon";
-        
-        // Applications généralement téléchargées
-        mime_types[".pdf"] = "application/pdf";
-        mime_types[".zip"] = "application/zip";
-        mime_types[".gz"] = "application/gzip";
-        mime_types[".tar"] = "application/x-tar";
-        
-        // Médias
-        mime_types[".mp3"] = "audio/mpeg";
-        mime_types[".mp4"] = "video/mp4";
-        mime_types[".mpeg"] = "video/mpeg";
-        mime_types[".avi"] = "video/x-msvideo";
-        mime_types[".webm"] = "video/webm";
-        mime_types[".wav"] = "audio/wav";
-        mime_types[".ogg"] = "audio/ogg";
-        
-        // Polices
-        mime_types[".woff"] = "font/woff";
-        mime_types[".woff2"] = "font/woff2";
-        mime_types[".ttf"] = "font/ttf";
-        mime_types[".otf"] = "font/otf";
-        mime_types[".eot"] = "application/vnd.ms-fontobject";
-        
-        // CGI
-        mime_types[".php"] = "text/html"; // PHP sera traité par CGI
-    }
-
-    // Trouver la position du '.' dans le chemin du fichier
-    size_t dot_pos = file_path.find_last_of('.');
-    if (dot_pos == std::string::npos) {
-        return "application/octet-stream"; // Type par défaut
-    }
-
-    std::string extension = file_path.substr(dot_pos); // Extraire l'extension du fichier
-    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower); // Convertir en minuscules
-    
-    std::map<std::string, std::string>::const_iterator it = mime_types.find(extension); // Chercher le type MIME
-    return it != mime_types.end() ? it->second : "application/octet-stream"; // Retourner le type MIME ou la valeur par défaut
+const std::string& getMimeType(const std::string& file_path) {
+    return MimeTypes::lookup(file_path);
 }
 
 /**
@@ -345,15 +455,22 @@ std::string getMimeType(const std::string& file_path) {
 std::string calculateETag(const std::string& file_path) {
     struct stat file_info;
     if (stat(file_path.c_str(), &file_info) == 0) {
-        // Calculer un ETag simple basé sur la taille et la date de modification
-        // Ce format est suffisant pour la plupart des cas d'utilisation
-        std::stringstream etag;
-        etag << "\"" << file_info.st_size << "-" << file_info.st_mtime << "\"";
-        return etag.str();
+        return calculateETag(file_info.st_size, file_info.st_mtime);
     }
     return "\"0\"";  // Même valeur par défaut que dans RouteHandler
 }
 
+/**
+ * @brief Calcule l'ETag à partir de métadonnées déjà connues (sans stat)
+ */
+std::string calculateETag(off_t size, time_t mtime) {
+    // Calculer un ETag simple basé sur la taille et la date de modification
+    // Ce format est suffisant pour la plupart des cas d'utilisation
+    std::stringstream etag;
+    etag << "\"" << size << "-" << mtime << "\"";
+    return etag.str();
+}
+
 /**
  * @brief Vérifie si une réponse 304 Not Modified peut être envoyée
  * @param request La requête HTTP
@@ -373,13 +490,12 @@ bool checkNotModified(const HttpRequest& request, const std::string& file_path,
     }
     
     // Vérifier les en-têtes de la requête
-    const std::map<std::string, std::string>& headers = request.getHeaders();
-    std::map<std::string, std::string>::const_iterator it = headers.find("if-none-match");
+    const std::string& if_none_match = request.getHeader(HEADER_IF_NONE_MATCH);
     
     // Si l'ETag correspondant a été trouvé
-    if (it != headers.end()) {
+    if (!if_none_match.empty()) {
         // Normaliser les ETags pour la comparaison
-        std::string normalized_client_etag = HttpStringUtils::normalizeETag(it->second);
+        std::string normalized_client_etag = HttpStringUtils::normalizeETag(if_none_match);
         std::string normalized_server_etag = HttpStringUtils::normalizeETag(etag);
         
         // Si l'ETag correspond après normalisation, répondre avec 304 Not Modified
@@ -395,10 +511,7 @@ bool checkNotModified(const HttpRequest& request, const std::string& file_path,
     // Ajouter aussi Last-Modified pour compatibilité
     struct stat file_stat;
     if (stat(file_path.c_str(), &file_stat) == 0) {
-        char last_modified[100];
-        struct tm* tm_info = gmtime(&file_stat.st_mtime);
-        strftime(last_modified, sizeof(last_modified), "%a, %d %b %Y %H:%M:%S GMT", tm_info);
-        response.setHeader("Last-Modified", last_modified);
+        response.setHeader("Last-Modified", HttpDate::format(file_stat.st_mtime));
     }
     
     return false;
@@ -19,14 +19,22 @@
 #include "http/utils/HttpUtils.hpp"
 
 HttpResponse RouteHandler::processRequest(const HttpRequest& request) {
+    HttpResponse response = routeRequest(request);
+    compressResponse(request, response);
+    return response;
+}
+
+HttpResponse RouteHandler::routeRequest(const HttpRequest& request) {
     const std::string& uri = request.getUri();
 
     // Logique pour la page secrète et la gestion des sessions
     if (uri == "/secret") {
         HttpResponse response;
-        std::string secret_file_path = root_directory + "/secret/index.html";
-        if (FileUtils::fileExists(secret_file_path)) {
-            if (serveStaticFile(secret_file_path, response)) {
+        StaticResource secret;
+        secret.path = root_directory + "/secret/index.html";
+        if (open_files.lookup(secret.path, secret.info)) {
+            describeResource(secret);
+            if (serveStaticFile(secret, response)) {
                 // Definir le cookie de session apres avoir servi le fichier
                 std::string session_id = CookieSessionManager::generateSessionId();
                 CookieSessionManager::setSessionCookie(response, session_id);
@@ -91,7 +99,8 @@ HttpResponse RouteHandler::processRequest(const HttpRequest& request) {
     // Si elle existe mais n'a pas de location définie, retourner 403 Forbidden
     if (location == NULL) {
         std::string file_path_check = getFilePath(uri, false); // Ne pas logger ici
-        if (FileUtils::fileExists(file_path_check)) {
+        FileInfo info;
+        if (open_files.lookup(file_path_check, info)) {
             // Ressource existe mais pas de location définie -> Forbidden
             LOG_WARNING("Access to existing resource without defined location: " << uri);
             return serveErrorPage(403, "Forbidden - No defined location for this resource");
@@ -100,24 +109,18 @@ HttpResponse RouteHandler::processRequest(const HttpRequest& request) {
     }
     
     // Vérifier si la méthode est autorisée dans cette location (si une location a été trouvée)
-    if (location != NULL) {
-        bool method_allowed = false;
-        for (size_t i = 0; i < location->allowed_methods.size(); ++i) {
-            if (location->allowed_methods[i] == request.getMethod()) {
-                method_allowed = true;
-                break;
-            }
-        }
-        
-        if (!method_allowed) {
-            return serveErrorPage(405, "Method Not Allowed");
-        }
+    if (location != NULL && !isMethodAllowed(*location, request.getMethod())) {
+        return serveErrorPage(405, "Method Not Allowed");
     }
     
     std::string file_path = getFilePath(uri, true);
     
     if (request.getMethod() == "GET") {
-        return handleGetRequest(request);
+        HttpResponse cached;
+        if (serveCachedResponse(request, responseCacheKey(file_path, acceptedEncodings(request, location)), cached)) {
+            return cached;
+        }
+        return handleGetRequest(request, file_path, location);
     }
     else if (request.getMethod() == "POST") {
         return handlePostRequest(request, file_path);
@@ -129,17 +132,85 @@ HttpResponse RouteHandler::processRequest(const HttpRequest& request) {
     return serveErrorPage(405, "Method Not Allowed");
 }
 
-HttpResponse RouteHandler::handleGetRequest(const HttpRequest& request) {
+/**
+ * @brief Vérifie la méthode d'une requête avant d'en recevoir le body
+ * 
+ * Mêmes règles que processRequest() pour les méthodes : utilisé pour
+ * répondre à "Expect: 100-continue" sans attendre le body.
+ * @return 0 si la requête peut continuer, sinon le code d'erreur (405)
+ */
+int RouteHandler::checkMethod(const std::string& method, const std::string& uri) const {
+    if (uri == "/secret" || uri == "/restricted-area") {
+        return 0; // Pages de session servies quelle que soit la méthode
+    }
+    if (method != "GET" && method != "POST" && method != "DELETE") {
+        return 405;
+    }
+    const LocationConfig* location = findMatchingLocation(uri);
+    if (location != NULL && location->redirect_code == 0 && !isMethodAllowed(*location, method)) {
+        return 405;
+    }
+    return 0;
+}
+
+bool RouteHandler::isMethodAllowed(const LocationConfig& location, const std::string& method) {
+    for (size_t i = 0; i < location.allowed_methods.size(); ++i) {
+        if (location.allowed_methods[i] == method) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Sert une réponse préconstruite du cache mémoire
+ * 
+ * Les requêtes conditionnelles suivent le chemin normal : elles peuvent
+ * appeler une réponse 304. De même pour Range, qui appelle une réponse 206.
+ * @return true si la réponse vient du cache
+ */
+bool RouteHandler::serveCachedResponse(const HttpRequest& request, const std::string& key, HttpResponse& response) {
+    if (!response_cache.enabled()
+        || !request.getHeader(HEADER_IF_NONE_MATCH).empty()
+        || !request.getHeader(HEADER_IF_MODIFIED_SINCE).empty()
+        || !request.getHeader(HEADER_RANGE).empty()) {
+        return false;
+    }
+    SharedBuffer raw;
+    if (!response_cache.lookup(key, raw)) {
+        return false;
+    }
+    response.setPrebuilt(200, raw);
+    return true;
+}
+
+/**
+ * @brief Applique les modifications de fichiers signalées par inotify
+ */
+void RouteHandler::handleFileEvents() {
+    std::vector<std::string> invalidated;
+    response_cache.processEvents(invalidated);
+    for (size_t i = 0; i < invalidated.size(); i++) {
+        open_files.invalidate(invalidated[i]); // Rouvert au prochain accès
+    }
+}
+
+HttpResponse RouteHandler::handleGetRequest(const HttpRequest& request, const std::string& file_path,
+                                            const LocationConfig* location) {
     HttpResponse response;
-    std::string file_path = getFilePath(request.getUri(), false);
-    
+
+    // Un seul open() + fstat() (ou aucun si le fichier est en cache) pour toutes les vérifications
+    StaticResource resource;
+    resource.path = file_path;
+    FileInfo& info = resource.info;
+
     // Vérifier d'abord si le fichier existe | Cas: 404
-    if (!FileUtils::fileExists(file_path)) {
+    if (!open_files.lookup(file_path, info)) {
         return serveErrorPage(404, "Not Found");
     }
 
     // Ensuite vérifier les permissions de lecture | Cas: 403
-    if (!FileUtils::hasReadPermission(file_path)) {
+    if (!info.readable) {
         return serveErrorPage(403, "Forbidden");
     }
 
@@ -149,7 +220,7 @@ HttpResponse RouteHandler::handleGetRequest(const HttpRequest& request) {
     }
 
     // Traitement des répertoires | Cas: 301 -> Rediriger vers le répertoire
-    if (FileUtils::isDirectory(file_path)) {
+    if (info.is_directory) {
         std::string uri = request.getUri();
         // Rediriger si l'URI ne se termine pas par '/'
         if (uri[uri.length() - 1] != '/') {
@@ -157,42 +228,281 @@ HttpResponse RouteHandler::handleGetRequest(const HttpRequest& request) {
             return response;
         }
 
-        // Chercher index.html
-        std::string index_path = file_path + "/index.html";
-        if (FileUtils::fileExists(index_path)) {
-            // Vérifier la validation du cache pour index.html
-            if (checkNotModified(request, index_path, response)) {
-                return response;
+        // Chercher index.html : la ressource servie est alors l'index
+        resource.path = file_path + "/index.html";
+        if (!open_files.lookup(resource.path, info)) {
+            // Vérifier si l'autoindex est activé pour cette location
+            if (location && !location->autoindex) {
+                return serveErrorPage(403, "Forbidden - Directory listing disabled");
             }
-            return serveStaticFile(index_path, response) ? 
-                response : serveErrorPage(500, "Internal Server Error");
-        }
-        
-        // Vérifier si l'autoindex est activé pour cette location
-        const LocationConfig* location = findMatchingLocation(uri);
-        if (location && !location->autoindex) {
-            return serveErrorPage(403, "Forbidden - Directory listing disabled");
+            
+            // Générer la liste du répertoire
+            std::string listing = FileUtils::generateDirectoryListing(file_path, uri);
+            response.setBody(listing, "text/html");
+            return response;
         }
-        
-        // Générer la liste du répertoire
-        std::string listing = FileUtils::generateDirectoryListing(file_path, uri);
-        response.setBody(listing, "text/html");
-        return response;
     }
 
+    // Variante précompressée (.br, .gz) acceptée par le client, si la location le permet
+    const bool gzip_static = location && location->gzip_static;
+    int encodings = acceptedEncodings(request, location);
+    resource.body_path = resource.path;
+    if (gzip_static && encodings) {
+        resource.encoding = findPrecompressed(resource.path, encodings, resource.body_path, info);
+    }
+    resource.mime_type = &getMimeType(resource.path);
+
+    // Sinon compression à la volée des types textuels (une fois par version du fichier)
+    const bool compressible = server_config.gzip && resource.encoding.empty() && info.size <= GZIP_MAX_STATIC_SIZE
+                           && gzip_encoder.shouldCompress(*resource.mime_type, info.size);
+    const bool compress = compressible && (encodings & ENCODING_GZIP);
+    if (compress) {
+        resource.encoding = "gzip";
+    }
+    describeResource(resource);
+
     // Vérifier la validation du cache avant de servir le fichier
-    if (checkNotModified(request, file_path, response)) {
+    if (checkNotModified(request, resource, response)) {
+        if (gzip_static || compressible) {
+            response.setHeader("Vary", "Accept-Encoding");
+        }
         return response;
     }
 
     // Servir le fichier statique | Cas: 500 -> Erreur interne du serveur
-    if (!serveStaticFile(file_path, response)) {
+    if (!serveStaticFile(resource, response)) {
         return serveErrorPage(500, "Internal Server Error");
     }
+    if (gzip_static || compressible) {
+        // La réponse (200 ou 206) dépend d'Accept-Encoding : les caches intermédiaires doivent le savoir
+        response.setHeader("Vary", "Accept-Encoding");
+    }
+    if (compress) {
+        SharedBuffer compressed;
+        if (!gzip_encoder.compressFile(resource.path, resource.etag, info.file, info.size, compressed)) {
+            return serveErrorPage(500, "Internal Server Error");
+        }
+        response.setBody(compressed, *resource.mime_type);
+        response.setHeader("Accept-Ranges", "none"); // Compressé en mémoire : envoyé en entier
+    } else {
+        response.setHeader("Accept-Ranges", "bytes");
+        if (serveRanges(request, resource, response)) {
+            return response; // 206 ou 416, jamais gardée dans le cache de réponses
+        }
+    }
 
+    // Les petits fichiers sont gardés en mémoire, réponse prête à l'envoi
+    response_cache.store(responseCacheKey(file_path, encodings), resource.body_path, info, response);
     return response;
 }
 
+/**
+ * @brief Calcule une fois les en-têtes dérivés des métadonnées de la ressource
+ * 
+ * Le type MIME est celui du fichier demandé, même si une variante
+ * précompressée est envoyée ; il n'est déterminé ici que s'il ne l'a pas
+ * déjà été.
+ */
+void RouteHandler::describeResource(StaticResource& resource) {
+    if (resource.body_path.empty()) {
+        resource.body_path = resource.path;
+    }
+    if (resource.mime_type == NULL) {
+        resource.mime_type = &getMimeType(resource.path);
+    }
+    resource.etag = representationETag(resource.info, resource.encoding);
+}
+
+/**
+ * @brief Réduit la réponse d'un fichier aux plages demandées par Range (RFC 9110 §14)
+ * 
+ * Une plage unique devient le body fichier lui-même, à partir de son
+ * offset ; plusieurs plages forment un body multipart/byteranges dont les
+ * portions sont envoyées par sendfile() comme un fichier entier. Le début
+ * du fichier n'est jamais lu.
+ * @return true si la réponse est devenue une 206 ou une 416, false pour envoyer le fichier entier
+ */
+bool RouteHandler::serveRanges(const HttpRequest& request, const StaticResource& resource, HttpResponse& response) {
+    const std::string& range = request.getHeader(HEADER_RANGE);
+    if (range.empty()) {
+        return false;
+    }
+    // If-Range : les plages ne valent que pour la version que le client possède déjà
+    const std::string& if_range = request.getHeader(HEADER_IF_RANGE);
+    if (!if_range.empty() && !ifRangeMatches(if_range, resource)) {
+        return false;
+    }
+
+    const FileInfo& info = resource.info;
+    std::vector<HttpStringUtils::ByteRange> ranges;
+    HttpStringUtils::RangeResult result = HttpStringUtils::parseRange(range, info.size, ranges);
+    if (result == HttpStringUtils::RANGE_IGNORED) {
+        return false;
+    }
+    std::ostringstream total;
+    total << "/" << info.size;
+    if (result == HttpStringUtils::RANGE_UNSATISFIABLE) {
+        response = serveErrorPage(416, "Range Not Satisfiable");
+        response.setHeader("Content-Range", "bytes *" + total.str());
+        return true;
+    }
+    if (ranges.size() > 1 && !resource.encoding.empty()) {
+        return false; // Content-Encoding s'appliquerait au multipart, pas aux parties
+    }
+
+    const std::string& content_type = *resource.mime_type;
+    if (ranges.size() == 1) {
+        std::ostringstream content_range;
+        content_range << "bytes " << ranges[0].first << "-" << ranges[0].last << total.str();
+        response.setFileBody(info.file, ranges[0].first, ranges[0].last - ranges[0].first + 1, content_type);
+        response.setHeader("Content-Range", content_range.str());
+        response.setStatus(206);
+        return true;
+    }
+
+    // Délimiteur propre à chaque réponse
+    static unsigned long boundary_count = 0;
+    std::ostringstream boundary;
+    boundary << std::setfill('0') << std::setw(10) << ++boundary_count << std::hex << time(NULL);
+
+    std::vector<FilePart> parts(ranges.size() + 1);
+    for (size_t i = 0; i < ranges.size(); i++) {
+        std::ostringstream head;
+        head << "\r\n--" << boundary.str() << "\r\n"
+             << "Content-Type: " << content_type << "\r\n"
+             << "Content-Range: bytes " << ranges[i].first << "-" << ranges[i].last << total.str() << "\r\n\r\n";
+        parts[i].head = head.str();
+        parts[i].offset = ranges[i].first;
+        parts[i].length = ranges[i].last - ranges[i].first + 1;
+    }
+    parts.back().head = "\r\n--" + boundary.str() + "--\r\n";
+    parts.back().offset = 0;
+    parts.back().length = 0;
+
+    response.setFileParts(info.file, parts, "multipart/byteranges; boundary=" + boundary.str());
+    response.setStatus(206);
+    return true;
+}
+
+/**
+ * @brief Compare If-Range à la représentation servie
+ * 
+ * Un ETag est comparé de façon forte (un ETag faible ne correspond jamais),
+ * une date à Last-Modified.
+ */
+bool RouteHandler::ifRangeMatches(const std::string& if_range, const StaticResource& resource) {
+    if (if_range[0] == '"') {
+        return if_range == resource.etag;
+    }
+    if (if_range.compare(0, 2, "W/") == 0) {
+        return false;
+    }
+    return if_range == resource.info.last_modified;
+}
+
+/**
+ * @brief Compresse à la volée un body en mémoire (CGI, autoindex, pages générées)
+ * 
+ * Les fichiers statiques sont traités dans handleGetRequest(), avec leur cache.
+ */
+void RouteHandler::compressResponse(const HttpRequest& request, HttpResponse& response) {
+    if (!server_config.gzip || response.hasFileBody() || response.hasPrebuilt() || response.hasSharedBody()
+        || !response.getHeader("Content-Encoding").empty()) {
+        return;
+    }
+    std::string content_type = response.getHeader("Content-Type");
+    const std::string& body = response.getBody();
+    if (!gzip_encoder.shouldCompress(content_type, body.size())) {
+        return;
+    }
+    response.setHeader("Vary", "Accept-Encoding");
+    if (!HttpStringUtils::acceptsEncoding(request.getHeader(HEADER_ACCEPT_ENCODING), "gzip")) {
+        return;
+    }
+
+    std::string compressed;
+    if (!gzip_encoder.compress(body.data(), body.size(), compressed)) {
+        return; // Envoyé tel quel
+    }
+    response.setBody(compressed, content_type);
+    response.setHeader("Content-Encoding", "gzip");
+    std::string etag = response.getHeader("ETag");
+    if (etag.size() >= 2) {
+        etag.insert(etag.size() - 1, "-gzip");
+        response.setHeader("ETag", etag);
+    }
+}
+
+/**
+ * @brief Codages que le client accepte parmi ceux que le serveur peut produire
+ * 
+ * br n'est servi que précompressé (gzip_static) ; gzip l'est aussi à la volée.
+ * @return Combinaison de ENCODING_BR et ENCODING_GZIP (0 : fichier d'origine)
+ */
+int RouteHandler::acceptedEncodings(const HttpRequest& request, const LocationConfig* location) const {
+    const bool gzip_static = location && location->gzip_static;
+    if (!gzip_static && !server_config.gzip) {
+        return 0;
+    }
+    const std::string& accept_encoding = request.getHeader(HEADER_ACCEPT_ENCODING);
+    if (accept_encoding.empty()) {
+        return 0;
+    }
+    int encodings = 0;
+    if (gzip_static && HttpStringUtils::acceptsEncoding(accept_encoding, "br")) {
+        encodings |= ENCODING_BR;
+    }
+    if (HttpStringUtils::acceptsEncoding(accept_encoding, "gzip")) {
+        encodings |= ENCODING_GZIP;
+    }
+    return encodings;
+}
+
+/**
+ * @brief Cherche à côté du fichier une variante précompressée acceptée, .br puis .gz
+ * @param body_path Reçoit le chemin de la variante retenue
+ * @param info Reçoit les métadonnées de la variante retenue
+ * @return Le codage retenu ("br", "gzip"), ou une chaîne vide pour le fichier lui-même
+ */
+std::string RouteHandler::findPrecompressed(const std::string& file_path, int encodings,
+                                            std::string& body_path, FileInfo& info) {
+    static const struct {
+        int flag;
+        const char* suffix;
+        const char* coding;
+    } variants[] = {
+        { ENCODING_BR, ".br", "br" },
+        { ENCODING_GZIP, ".gz", "gzip" }
+    };
+
+    for (size_t i = 0; i < sizeof(variants) / sizeof(variants[0]); i++) {
+        if (!(encodings & variants[i].flag)) {
+            continue;
+        }
+        FileInfo variant;
+        std::string variant_path = file_path + variants[i].suffix;
+        if (open_files.lookup(variant_path, variant) && variant.is_regular && variant.readable) {
+            body_path = variant_path;
+            info = variant;
+            return variants[i].coding;
+        }
+    }
+    return "";
+}
+
+/**
+ * @brief Clé du cache de réponses : la réponse dépend aussi des codages acceptés
+ */
+std::string RouteHandler::responseCacheKey(const std::string& file_path, int encodings) {
+    if (encodings == 0) {
+        return file_path;
+    }
+    std::string key = file_path;
+    key += '#';
+    key += static_cast<char>('0' + encodings);
+    return key;
+}
+
 HttpResponse RouteHandler::handlePostRequest(const HttpRequest& request, const std::string& file_path) {
     // Si c'est une requête pour l'API tasks
     if (request.getUri().find("/api/tasks") == 0) {
@@ -201,7 +511,7 @@ HttpResponse RouteHandler::handlePostRequest(const HttpRequest& request, const s
     
     // Si c'est un upload de fichier
     if (request.getUri() == "/file-upload") {
-        const std::string& content_type = request.getHeader("content-type");
+        const std::string& content_type = request.getHeader(HEADER_CONTENT_TYPE);
         if (content_type.find("multipart/form-data") == std::string::npos) {
             return serveErrorPage(400, "Invalid Content-Type for file upload");
         }
@@ -272,6 +582,15 @@ HttpResponse RouteHandler::handleDeleteRequest(const HttpRequest& request) {
     if (std::remove(file_path.c_str()) != 0) {
         return serveErrorPage(500, "Failed to delete file");
     }
+    // Toutes les représentations du fichier (clés par codage) et ses variantes .gz/.br
+    std::vector<std::string> invalidated;
+    response_cache.invalidate(file_path, invalidated);
+    invalidated.push_back(file_path);
+    invalidated.push_back(file_path + ".gz");
+    invalidated.push_back(file_path + ".br");
+    for (size_t i = 0; i < invalidated.size(); i++) {
+        open_files.invalidate(invalidated[i]);
+    }
     
     // Réponse réussie (No Content)
     response.setStatus(204);
@@ -322,38 +641,41 @@ std::string RouteHandler::getFilePath(const std::string& uri, bool log) const {
 }
 
 bool RouteHandler::serveStaticFile(const std::string& file_path, HttpResponse& response) {
-    // Ouvrir le fichier
-    std::ifstream file(file_path.c_str(), std::ios::binary); 
-    if (!file) {
+    StaticResource resource;
+    resource.path = file_path;
+    if (!open_files.lookup(file_path, resource.info)) {
         return false;
     }
+    describeResource(resource);
+    return serveStaticFile(resource, response);
+}
 
-    // Lire le contenu du fichier
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    std::string content = buffer.str();
+bool RouteHandler::serveStaticFile(const StaticResource& resource, HttpResponse& response) {
+    const FileInfo& info = resource.info;
+    const std::string& file_path = resource.path;
+    const std::string& mime_type = *resource.mime_type;
 
-    // Définir le type MIME
-    std::string mime_type = getMimeType(file_path);
+    // Le fichier est déjà ouvert : il sera envoyé par sendfile() sans être lu en mémoire
+    if (!info.is_regular || !info.file.isOpen()) {
+        return false;
+    }
 
     // Définir le body de la réponse avec le bon type MIME
-    response.setBody(content, mime_type);
+    response.setFileBody(info.file, 0, info.size, mime_type);
+    if (!resource.encoding.empty()) {
+        // Variante précompressée : le type reste celui du fichier d'origine
+        response.setHeader("Content-Encoding", resource.encoding);
+    }
 
     // Ajouter l'ETag pour la validation du cache
-    response.setHeader("ETag", calculateETag(file_path));
+    response.setHeader("ETag", resource.etag);
     
     // Configuration simple du Cache-Control
     // Les fichiers statiques sont mis en cache pendant 1 heure par défaut
     response.setHeader("Cache-Control", "public, max-age=3600");
     
     // Ajouter la date de dernière modification
-    struct stat file_stat;
-    if (stat(file_path.c_str(), &file_stat) == 0) {
-        char last_modified[100];
-        struct tm* tm_info = gmtime(&file_stat.st_mtime);
-        strftime(last_modified, sizeof(last_modified), "%a, %d %b %Y %H:%M:%S GMT", tm_info);
-        response.setHeader("Last-Modified", last_modified);
-    }
+    response.setHeader("Last-Modified", resource.info.last_modified);
 
     // Ajouter Content-Disposition: attachment pour les fichiers à télécharger
     // Pour forcer le téléchargement au lieu de l'affichage dans le navigateur
@@ -402,44 +724,43 @@ bool RouteHandler::serveStaticFile(const std::string& file_path, HttpResponse& r
     return true;
 }
 
-bool RouteHandler::checkNotModified(const HttpRequest& request, const std::string& file_path, HttpResponse& response) {
+/**
+ * @brief ETag d'une représentation : une variante compressée a le sien (RFC 9110 §8.8.3)
+ */
+std::string RouteHandler::representationETag(const FileInfo& info, const std::string& encoding) {
+    std::string etag = calculateETag(info.size, info.mtime);
+    if (!encoding.empty()) {
+        etag.insert(etag.size() - 1, "-" + encoding);
+    }
+    return etag;
+}
+
+bool RouteHandler::checkNotModified(const HttpRequest& request, const StaticResource& resource, HttpResponse& response) {
     // Vérifier si le client a envoyé un ETag
-    std::string if_none_match = request.getHeader("If-None-Match");
+    const std::string& if_none_match = request.getHeader(HEADER_IF_NONE_MATCH);
     
     if (!if_none_match.empty()) {
-        // Calculer l'ETag de la ressource
-        std::string etag = calculateETag(file_path);
-        
         // Normaliser les ETags pour la comparaison (enlever les guillemets)
         std::string normalized_client_etag = HttpStringUtils::normalizeETag(if_none_match);
-        std::string normalized_server_etag = HttpStringUtils::normalizeETag(etag);
+        std::string normalized_server_etag = HttpStringUtils::normalizeETag(resource.etag);
         
         // Vérifier si l'ETag correspond après normalisation
         if (normalized_client_etag == normalized_server_etag) {
             // La ressource n'a pas été modifiée
-            response.setNotModified(etag);
+            response.setNotModified(resource.etag);
             return true;
         }
     }
     
     // Vérifier si le client a envoyé une date de dernière modification
-    std::string if_modified_since = request.getHeader("If-Modified-Since");
+    const std::string& if_modified_since = request.getHeader(HEADER_IF_MODIFIED_SINCE);
     if (!if_modified_since.empty()) {
-        // Obtenir la date de dernière modification du fichier
-        struct stat file_stat;
-        if (stat(file_path.c_str(), &file_stat) == 0) {
-            // Convertir la date du fichier en format HTTP
-            struct tm* tm_info = gmtime(&file_stat.st_mtime);
-            char last_modified[100];
-            strftime(last_modified, sizeof(last_modified), "%a, %d %b %Y %H:%M:%S GMT", tm_info);
-            
-            // Vérifier si la date correspond
-            if (if_modified_since == last_modified) {
-                // La ressource n'a pas été modifiée
-                response.setStatus(304);
-                response.setHeader("Last-Modified", last_modified);
-                return true;
-            }
+        // Vérifier si la date correspond
+        if (if_modified_since == resource.info.last_modified) {
+            // La ressource n'a pas été modifiée
+            response.setStatus(304);
+            response.setHeader("Last-Modified", resource.info.last_modified);
+            return true;
         }
     }
     
@@ -447,28 +768,32 @@ bool RouteHandler::checkNotModified(const HttpRequest& request, const std::strin
     return false;
 }
 
+/**
+ * @brief Charge les pages error_page de la configuration
+ * 
+ * Appelée au démarrage et sur SIGHUP : une page modifiée sur le disque
+ * n'est prise en compte qu'au rechargement.
+ */
+size_t RouteHandler::loadErrorPages() {
+    return error_pages.load(root_directory, server_config.error_pages);
+}
+
+/**
+ * @brief Réponse d'erreur dont le body est un tampon préchargé, partagé sans copie
+ * 
+ * Ni accès disque ni HTML reconstruit : seuls la ligne de statut et les
+ * en-têtes sont sérialisés pour chaque erreur.
+ */
 HttpResponse RouteHandler::serveErrorPage(int error_code, const std::string& message) {
-    // Check if there's a custom error page for this error code
-    std::map<int, std::string>::const_iterator it = server_config.error_pages.find(error_code);
-    if (it != server_config.error_pages.end()) {
-        // Use custom error page
-        std::string error_page_path = root_directory + "/" + it->second;
-        if (FileUtils::fileExists(error_page_path)) {
-            HttpResponse response;
-            response.setStatus(error_code);
-            if (serveStaticFile(error_page_path, response)) {
-                // Désactiver le cache pour les pages d'erreur
-                response.setHeader("Cache-Control", "no-store, no-cache, must-revalidate, max-age=0");
-                response.setHeader("Pragma", "no-cache");
-                return response;
-            }
-            // If failed to serve the custom error page, fall back to default
-        }
-    }
-    
-    // Default error page generation if no custom page is available or failed to serve
-    HttpResponse response = HttpResponse::createError(error_code, message);
-    // Désactiver le cache pour les pages d'erreur par défaut aussi
+    HttpResponse response;
+    response.setStatus(error_code);
+    const ErrorPages::Page* page = error_pages.find(error_code);
+    if (page) {
+        response.setBody(page->body, *page->content_type);
+    } else {
+        response.setBody(error_pages.defaultPage(error_code, message), "text/html");
+    }
+    // Désactiver le cache pour les pages d'erreur
     response.setHeader("Cache-Control", "no-store, no-cache, must-revalidate, max-age=0");
     response.setHeader("Pragma", "no-cache");
     return response;
@@ -0,0 +1,60 @@
+#include "http/parser/ByteScanner.hpp"
+#include <cstring>
+
+#if defined(__SSE2__)
+# include <emmintrin.h>
+#endif
+
+namespace ByteScanner {
+
+size_t findSequence(const char* data, size_t size, size_t from, const char* needle, size_t needle_size) {
+    if (needle_size == 0) {
+        return from <= size ? from : std::string::npos;
+    }
+    if (needle_size == 1) {
+        if (from >= size) {
+            return std::string::npos;
+        }
+        const void* found = memchr(data + from, needle[0], size - from);
+        return found ? static_cast<const char*>(found) - data : std::string::npos;
+    }
+
+    size_t i = from;
+    const size_t last = needle_size - 1;
+
+#if defined(__SSE2__)
+    const __m128i first16 = _mm_set1_epi8(needle[0]);
+    const __m128i last16 = _mm_set1_epi8(needle[last]);
+    for (; i + last + 16 <= size; i += 16) {
+        __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i block_last = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + last));
+        unsigned int mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(block_first, first16),
+                                                            _mm_cmpeq_epi8(block_last, last16)));
+        while (mask) {
+            size_t candidate = i + __builtin_ctz(mask);
+            if (memcmp(data + candidate + 1, needle + 1, needle_size - 2) == 0) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+#endif
+
+    for (; i + needle_size <= size; i++) {
+        if (data[i] == needle[0] && data[i + last] == needle[last]
+            && memcmp(data + i + 1, needle + 1, needle_size - 2) == 0) {
+            return i;
+        }
+    }
+    return std::string::npos;
+}
+
+const char* implementation() {
+#if defined(__SSE2__)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+} // namespace ByteScanner
@@ -0,0 +1,143 @@
+#include "http/parser/ChunkedDecoder.hpp"
+#include "http/HttpRequest.hpp"
+
+ChunkedDecoder::ChunkedDecoder()
+    : max_body_size(HttpRequest::DEFAULT_MAX_BODY_SIZE) {
+    reset();
+}
+
+void ChunkedDecoder::reset() {
+    state = STATE_SIZE;
+    chunk_size = 0;
+    remaining = 0;
+    line_length = 0;
+    size_digits = false;
+    decoded_size = 0;
+    error_code = 0;
+}
+
+ChunkedDecoder::Result ChunkedDecoder::fail(int code) {
+    state = STATE_ERROR;
+    error_code = code;
+    return DECODE_ERROR;
+}
+
+static int hexValue(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+/**
+ * @brief Décode les octets disponibles et reprend au prochain appel là où il s'est arrêté
+ *
+ * La taille de chaque chunk est comparée à la limite dès que sa ligne est
+ * lue : un body trop grand est refusé (413) avant d'en recevoir les données.
+ */
+ChunkedDecoder::Result ChunkedDecoder::decode(const char* data, size_t size, size_t& consumed, std::string& body) {
+    size_t pos = 0;
+
+    while (pos < size && state != STATE_DONE && state != STATE_ERROR) {
+        char c = data[pos];
+
+        switch (state) {
+            case STATE_SIZE: {
+                int digit = hexValue(c);
+                if (digit >= 0) {
+                    if (chunk_size > (static_cast<size_t>(-1) >> 4)) {
+                        consumed = pos;
+                        return fail(413); // Taille démesurée
+                    }
+                    chunk_size = chunk_size * 16 + digit;
+                    size_digits = true;
+                    line_length++;
+                    pos++;
+                } else if (size_digits && (c == ';' || c == ' ' || c == '\t' || c == '\r' || c == '\n')) {
+                    state = STATE_EXTENSION; // La fin de ligne est traitée avec les extensions
+                } else {
+                    consumed = pos;
+                    return fail(400);
+                }
+                break;
+            }
+
+            case STATE_EXTENSION:
+                pos++;
+                if (c != '\n') {
+                    if (++line_length > MAX_CHUNK_LINE_SIZE) {
+                        consumed = pos;
+                        return fail(400);
+                    }
+                    break;
+                }
+                line_length = 0;
+                if (chunk_size == 0) {
+                    state = STATE_TRAILER; // Dernier chunk
+                } else if (chunk_size > max_body_size - decoded_size) {
+                    consumed = pos;
+                    return fail(413);
+                } else {
+                    remaining = chunk_size;
+                    state = STATE_DATA;
+                }
+                break;
+
+            case STATE_DATA: {
+                size_t n = size - pos < remaining ? size - pos : remaining;
+                body.append(data + pos, n);
+                pos += n;
+                remaining -= n;
+                decoded_size += n;
+                if (remaining == 0) {
+                    state = STATE_DATA_END;
+                }
+                break;
+            }
+
+            case STATE_DATA_END:
+                if (c == '\r' && line_length == 0) {
+                    line_length = 1;
+                    pos++;
+                } else if (c == '\n') {
+                    pos++;
+                    chunk_size = 0;
+                    size_digits = false;
+                    line_length = 0;
+                    state = STATE_SIZE;
+                } else {
+                    consumed = pos;
+                    return fail(400);
+                }
+                break;
+
+            case STATE_TRAILER:
+                pos++;
+                if (c == '\n') {
+                    if (line_length == 0) {
+                        state = STATE_DONE; // Ligne vide : fin du message
+                    }
+                    line_length = 0;
+                } else if (c != '\r' && ++line_length > MAX_CHUNK_LINE_SIZE) {
+                    consumed = pos;
+                    return fail(400);
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    consumed = pos;
+    if (state == STATE_ERROR) {
+        return DECODE_ERROR;
+    }
+    return state == STATE_DONE ? DECODE_DONE : DECODE_AGAIN;
+}
@@ -1,4 +1,5 @@
 #include "http/parser/FormParser.hpp"
+#include "http/parser/ByteScanner.hpp"
 #include "http/utils/HttpUtils.hpp"
 #include "utils/Common.hpp"
 #include <sstream>
@@ -124,7 +125,9 @@ void FormParser::parseMultipart(const std::string& body, const std::string& boun
     size_t pos = 0;
     size_t boundary_pos;
     
-    boundary_pos = body.find(full_boundary);
+    // Recherche vectorisée : seuls les candidats dont le premier et le dernier
+    // octet correspondent au boundary sont comparés en entier
+    boundary_pos = ByteScanner::findSequence(body.data(), body.size(), 0, full_boundary.data(), full_boundary.size());
     if (boundary_pos == std::string::npos) {
         LOG_ERROR("No boundary found in body");
         return;
@@ -137,7 +140,7 @@ void FormParser::parseMultipart(const std::string& body, const std::string& boun
             break;
         }
         
-        boundary_pos = body.find(full_boundary, pos);
+        boundary_pos = ByteScanner::findSequence(body.data(), body.size(), pos, full_boundary.data(), full_boundary.size());
         if (boundary_pos == std::string::npos) {
             boundary_pos = body.length();
         }
@@ -161,7 +164,7 @@ void FormParser::parseMultipart(const std::string& body, const std::string& boun
 }
 
 void FormParser::parseMultipartPart(const std::string& part, FormData& form_data) {
-    size_t header_end = part.find("\r\n\r\n");
+    size_t header_end = ByteScanner::findSequence(part.data(), part.size(), 0, "\r\n\r\n", 4);
     if (header_end == std::string::npos) {
         LOG_ERROR("Invalid multipart part: no header separation");
         return;
@@ -0,0 +1,250 @@
+#include "http/parser/RequestParser.hpp"
+#include <cstring>
+#include <cctype>
+
+RequestParser::RequestParser() {
+    reset();
+}
+
+/**
+ * @brief Prépare le parser pour une nouvelle requête
+ */
+void RequestParser::reset() {
+    state = STATE_REQUEST_LINE;
+    line_start = 0;
+    scan_pos = 0;
+    error_code = 0;
+    method = Span();
+    target = Span();
+    version = Span();
+    headers.clear(); // Conserve la capacité d'une requête à l'autre
+    headers_end = 0;
+    has_content_length = false;
+    content_length = 0;
+    chunked = false;
+}
+
+RequestParser::Result RequestParser::fail(int code) {
+    state = STATE_ERROR;
+    error_code = code;
+    return PARSE_ERROR;
+}
+
+/**
+ * @brief Fait avancer l'analyse avec les octets disponibles
+ *
+ * Chaque ligne n'est parcourue qu'une fois : la recherche de fin de ligne
+ * reprend à scan_pos, et une ligne incomplète est terminée au prochain appel.
+ */
+RequestParser::Result RequestParser::feed(const char* data, size_t size) {
+    while (state == STATE_REQUEST_LINE || state == STATE_HEADERS) {
+        const char* nl = static_cast<const char*>(memchr(data + scan_pos, '\n', size - scan_pos));
+        if (!nl) {
+            scan_pos = size;
+            if (size > MAX_HEADERS_SIZE) {
+                return fail(state == STATE_REQUEST_LINE ? 414 : 431);
+            }
+            return PARSE_AGAIN;
+        }
+
+        size_t eol = nl - data;
+        if (eol >= MAX_HEADERS_SIZE) {
+            return fail(state == STATE_REQUEST_LINE ? 414 : 431);
+        }
+        size_t end = eol;
+        if (end > line_start && data[end - 1] == '\r') {
+            end--;
+        }
+
+        if (state == STATE_REQUEST_LINE) {
+            // Les lignes vides avant la ligne de requête sont ignorées (RFC 9112 §2.2)
+            if (end != line_start) {
+                if (!parseRequestLine(data, line_start, end)) {
+                    return fail(400);
+                }
+                state = STATE_HEADERS;
+            }
+        } else if (end == line_start) {
+            // Ligne vide : fin des en-têtes
+            if (chunked && has_content_length) {
+                return fail(400); // Ambiguïté exploitable (request smuggling) : refusée (RFC 9112 §6.3)
+            }
+            headers_end = eol + 1;
+            state = STATE_BODY;
+        } else if (!parseHeaderLine(data, line_start, end)) {
+            return fail(error_code ? error_code : 400);
+        }
+
+        line_start = eol + 1;
+        scan_pos = line_start;
+    }
+
+    // Un body chunked est décodé par l'appelant, qui termine la requête avec completeBody()
+    if (state == STATE_BODY && !chunked && size >= headers_end + content_length) {
+        state = STATE_COMPLETE;
+    }
+
+    if (state == STATE_ERROR) {
+        return PARSE_ERROR;
+    }
+    return state == STATE_COMPLETE ? PARSE_COMPLETE : PARSE_AGAIN;
+}
+
+/**
+ * @brief Découpe la ligne de requête : méthode, cible et version
+ */
+bool RequestParser::parseRequestLine(const char* data, size_t start, size_t end) {
+    size_t pos = start;
+
+    // Méthode : lettres majuscules uniquement
+    while (pos < end && data[pos] >= 'A' && data[pos] <= 'Z') {
+        pos++;
+    }
+    if (pos == start || pos >= end || data[pos] != ' ') {
+        return false;
+    }
+    method = Span(start, pos - start);
+
+    // Cible
+    while (pos < end && data[pos] == ' ') {
+        pos++;
+    }
+    size_t target_start = pos;
+    while (pos < end && data[pos] != ' ') {
+        if (static_cast<unsigned char>(data[pos]) <= 0x1F || data[pos] == 0x7F) {
+            return false;
+        }
+        pos++;
+    }
+    if (pos == target_start || pos >= end) {
+        return false;
+    }
+    target = Span(target_start, pos - target_start);
+
+    // Version
+    while (pos < end && data[pos] == ' ') {
+        pos++;
+    }
+    size_t version_end = end;
+    while (version_end > pos && data[version_end - 1] == ' ') {
+        version_end--;
+    }
+    version = Span(pos, version_end - pos);
+    if (version.length != 8 || memcmp(data + pos, "HTTP/1.", 7) != 0
+        || (data[pos + 7] != '0' && data[pos + 7] != '1')) {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Repère le nom et la valeur d'un en-tête "Nom: valeur"
+ */
+bool RequestParser::parseHeaderLine(const char* data, size_t start, size_t end) {
+    // Les en-têtes repliés (obs-fold) et les espaces avant ':' sont refusés (RFC 9112 §5)
+    if (data[start] == ' ' || data[start] == '\t') {
+        return false;
+    }
+
+    const char* colon = static_cast<const char*>(memchr(data + start, ':', end - start));
+    if (!colon || colon == data + start) {
+        return false;
+    }
+    size_t name_end = colon - data;
+    for (size_t i = start; i < name_end; i++) {
+        if (data[i] == ' ' || data[i] == '\t') {
+            return false;
+        }
+    }
+
+    size_t value_start = name_end + 1;
+    while (value_start < end && (data[value_start] == ' ' || data[value_start] == '\t')) {
+        value_start++;
+    }
+    size_t value_end = end;
+    while (value_end > value_start && (data[value_end - 1] == ' ' || data[value_end - 1] == '\t')) {
+        value_end--;
+    }
+
+    HeaderSpan header;
+    header.name = Span(start, name_end - start);
+    header.value = Span(value_start, value_end - value_start);
+    headers.push_back(header);
+
+    if (equalsIgnoreCase(data, header.name, "content-length")) {
+        return parseContentLength(data, header.value);
+    }
+    if (equalsIgnoreCase(data, header.name, "transfer-encoding")) {
+        error_code = parseTransferEncoding(data, header.value);
+        return error_code == 0;
+    }
+    return true;
+}
+
+/**
+ * @brief Seul le codage "chunked" est pris en charge
+ * @return 0 si valide, sinon le code d'erreur (501 pour un codage inconnu)
+ */
+int RequestParser::parseTransferEncoding(const char* data, const Span& value) {
+    if (chunked) {
+        return 400; // chunked appliqué deux fois
+    }
+    if (!equalsIgnoreCase(data, value, "chunked")) {
+        return 501;
+    }
+    chunked = true;
+    return 0;
+}
+
+/**
+ * @brief Valide Content-Length : uniquement des chiffres, et deux valeurs identiques si répété
+ */
+bool RequestParser::parseContentLength(const char* data, const Span& value) {
+    if (value.empty()) {
+        return false;
+    }
+
+    size_t length = 0;
+    for (size_t i = value.offset; i < value.offset + value.length; i++) {
+        if (!isdigit(static_cast<unsigned char>(data[i]))) {
+            return false;
+        }
+        size_t next = length * 10 + (data[i] - '0');
+        if (next < length) {
+            return false; // Débordement
+        }
+        length = next;
+    }
+
+    if (has_content_length && length != content_length) {
+        return false;
+    }
+    has_content_length = true;
+    content_length = length;
+    return true;
+}
+
+/**
+ * @brief Recherche un en-tête par nom (insensible à la casse)
+ */
+const HeaderSpan* RequestParser::findHeader(const char* data, const char* name) const {
+    for (size_t i = 0; i < headers.size(); i++) {
+        if (equalsIgnoreCase(data, headers[i].name, name)) {
+            return &headers[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Compare un Span à une chaîne en minuscules sans tenir compte de la casse
+ */
+bool RequestParser::equalsIgnoreCase(const char* data, const Span& span, const char* str) {
+    size_t i = 0;
+    for (; i < span.length; i++) {
+        if (str[i] == '\0' || tolower(static_cast<unsigned char>(data[span.offset + i])) != str[i]) {
+            return false;
+        }
+    }
+    return str[i] == '\0';
+}
@@ -0,0 +1,52 @@
+#include "http/utils/ErrorPages.hpp"
+#include "http/utils/MimeTypes.hpp"
+#include "http/HttpResponse.hpp"
+#include "utils/Common.hpp"
+#include <fstream>
+#include <iterator>
+
+ErrorPages::ErrorPages() {}
+
+size_t ErrorPages::load(const std::string& root, const std::map<int, std::string>& error_pages) {
+    pages.clear();
+    for (std::map<int, std::string>::const_iterator it = error_pages.begin(); it != error_pages.end(); ++it) {
+        std::string path = root + "/" + it->second;
+        std::ifstream file(path.c_str(), std::ios::binary);
+        if (!file) {
+            LOG_WARNING("Error page " << it->first << " unreadable, default page used: " << path);
+            continue;
+        }
+        std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        Page& page = pages[it->first];
+        page.body = SharedBuffer(content);
+        page.content_type = &MimeTypes::lookup(path);
+    }
+    return pages.size();
+}
+
+const ErrorPages::Page* ErrorPages::find(int code) const {
+    std::map<int, Page>::const_iterator it = pages.find(code);
+    return it != pages.end() ? &it->second : NULL;
+}
+
+/**
+ * @brief Construite une fois par message : les messages viennent de littéraux du code
+ */
+SharedBuffer ErrorPages::defaultPage(int code, const std::string& message) {
+    std::vector<DefaultPage>& known = defaults[code];
+    for (size_t i = 0; i < known.size(); i++) {
+        if (known[i].message == message) {
+            return known[i].body;
+        }
+    }
+
+    std::string content = HttpResponse::createError(code, message).getBody();
+    SharedBuffer body(content);
+    if (known.size() < MAX_DEFAULT_PAGES_PER_CODE) {
+        DefaultPage page;
+        page.message = message;
+        page.body = body;
+        known.push_back(page);
+    }
+    return body;
+}
@@ -0,0 +1,45 @@
+#include "http/utils/FileHandle.hpp"
+#include <unistd.h>
+#include <cstddef>
+
+FileHandle::FileHandle() : shared(NULL) {}
+
+FileHandle::FileHandle(int fd) : shared(NULL) {
+    if (fd >= 0) {
+        shared = new Shared;
+        shared->fd = fd;
+        shared->refs = 1;
+    }
+}
+
+FileHandle::FileHandle(const FileHandle& other) : shared(other.shared) {
+    if (shared) {
+        shared->refs++;
+    }
+}
+
+FileHandle& FileHandle::operator=(const FileHandle& other) {
+    if (shared != other.shared) {
+        reset();
+        shared = other.shared;
+        if (shared) {
+            shared->refs++;
+        }
+    }
+    return *this;
+}
+
+FileHandle::~FileHandle() {
+    reset();
+}
+
+/**
+ * @brief Abandonne la référence ; le fd est fermé par le dernier détenteur
+ */
+void FileHandle::reset() {
+    if (shared && --shared->refs == 0) {
+        close(shared->fd);
+        delete shared;
+    }
+    shared = NULL;
+}
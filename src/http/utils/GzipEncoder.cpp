@@ -0,0 +1,95 @@
+#include "http/utils/GzipEncoder.hpp"
+#include <zlib.h>
+#include <unistd.h>
+#include <cstring>
+
+GzipEncoder::GzipEncoder(int level, size_t min_length)
+    : level(level)
+    , min_length(min_length)
+    , cached_bytes(0) {}
+
+bool GzipEncoder::shouldCompress(const std::string& content_type, size_t size) const {
+    if (size < min_length) {
+        return false;
+    }
+    // Type sans ses paramètres (charset...)
+    size_t end = content_type.find(';');
+    std::string type = content_type.substr(0, end);
+    while (!type.empty() && type[type.size() - 1] == ' ') {
+        type.erase(type.size() - 1);
+    }
+    return type == "text/html" || type == "text/css"
+        || type == "application/json" || type == "application/javascript";
+}
+
+/**
+ * @brief Compression en un seul appel : la sortie est dimensionnée par deflateBound()
+ */
+bool GzipEncoder::compress(const char* data, size_t size, std::string& out) const {
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    // 15 + 16 : fenêtre maximale, en-tête et somme de contrôle gzip
+    if (deflateInit2(&stream, level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        out.clear();
+        return false;
+    }
+
+    out.resize(deflateBound(&stream, size));
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+    stream.avail_in = size;
+    stream.next_out = reinterpret_cast<Bytef*>(&out[0]);
+    stream.avail_out = out.size();
+
+    int result = deflate(&stream, Z_FINISH);
+    size_t produced = stream.total_out;
+    deflateEnd(&stream);
+    if (result != Z_STREAM_END) {
+        out.clear();
+        return false;
+    }
+    out.resize(produced);
+    return true;
+}
+
+bool GzipEncoder::compressFile(const std::string& key, const std::string& etag,
+                               const FileHandle& file, size_t size, SharedBuffer& out) {
+    std::string cache_key = key + ' ' + etag;
+    std::map<std::string, EntryList::iterator>::iterator it = index.find(cache_key);
+    if (it != index.end()) {
+        entries.splice(entries.begin(), entries, it->second); // Devient la plus récente
+        out = it->second->data;
+        return true;
+    }
+
+    // Lecture du fichier entier, sans toucher à sa position (fd partagé)
+    std::string content(size, '\0');
+    size_t done = 0;
+    while (done < size) {
+        ssize_t n = pread(file.fd(), &content[done], size - done, done);
+        if (n <= 0) {
+            return false; // Fichier tronqué depuis l'ouverture
+        }
+        done += n;
+    }
+    std::string compressed;
+    if (!compress(content.data(), content.size(), compressed)) {
+        return false;
+    }
+    out = SharedBuffer(compressed);
+
+    if (out.size() > GZIP_CACHE_MAX_BYTES) {
+        return true;
+    }
+    while (!entries.empty() && cached_bytes + out.size() > GZIP_CACHE_MAX_BYTES) {
+        cached_bytes -= entries.back().data.size(); // Les moins récemment utilisées d'abord
+        index.erase(entries.back().key);
+        entries.pop_back();
+    }
+    Entry entry;
+    entry.key = cache_key;
+    entries.push_front(entry);
+    entries.front().data = out;
+    index[cache_key] = entries.begin();
+    cached_bytes += out.size();
+    return true;
+}
@@ -0,0 +1,61 @@
+#include "http/utils/HttpDate.hpp"
+
+namespace HttpDate {
+
+static time_t cached_time = 0;
+static std::string cached_date;
+
+static void appendTwoDigits(std::string& out, int value) {
+    out += static_cast<char>('0' + value / 10);
+    out += static_cast<char>('0' + value % 10);
+}
+
+/**
+ * @brief Formate sans strftime() : noms anglais quelle que soit la locale
+ */
+std::string format(time_t t) {
+    static const char* const days[] = { "Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat" };
+    static const char* const months[] = { "Jan", "Feb", "Mar", "Apr", "May", "Jun",
+                                          "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" };
+    struct tm tm_info;
+    if (gmtime_r(&t, &tm_info) == NULL) {
+        return "";
+    }
+
+    std::string out;
+    out.reserve(29);
+    out += days[tm_info.tm_wday];
+    out += ", ";
+    appendTwoDigits(out, tm_info.tm_mday);
+    out += ' ';
+    out += months[tm_info.tm_mon];
+    out += ' ';
+    int year = tm_info.tm_year + 1900;
+    appendTwoDigits(out, year / 100);
+    appendTwoDigits(out, year % 100);
+    out += ' ';
+    appendTwoDigits(out, tm_info.tm_hour);
+    out += ':';
+    appendTwoDigits(out, tm_info.tm_min);
+    out += ':';
+    appendTwoDigits(out, tm_info.tm_sec);
+    out += " GMT";
+    return out;
+}
+
+const std::string& now() {
+    if (cached_date.empty()) {
+        update();
+    }
+    return cached_date;
+}
+
+void update() {
+    time_t t = time(NULL);
+    if (t != cached_time || cached_date.empty()) {
+        cached_time = t;
+        cached_date = format(t);
+    }
+}
+
+} // namespace HttpDate
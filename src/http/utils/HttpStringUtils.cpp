@@ -1,4 +1,8 @@
 #include "http/utils/HttpStringUtils.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <strings.h>
+#include <algorithm>
 
 namespace HttpStringUtils {
 
@@ -19,4 +23,173 @@ std::string normalizeETag(const std::string& etag) {
     return result;
 }
 
+/**
+ * @brief Vérifie un codage dans une liste "gzip;q=0.8, br, *;q=0" (RFC 9110 §12.5.3)
+ * 
+ * Une mention explicite du codage l'emporte sur "*" ; q=0 signifie refusé.
+ */
+bool acceptsEncoding(const std::string& accept_encoding, const char* coding) {
+    const size_t coding_len = strlen(coding);
+    double wildcard = -1;
+    size_t pos = 0;
+
+    while (pos < accept_encoding.size()) {
+        size_t end = accept_encoding.find(',', pos);
+        if (end == std::string::npos) {
+            end = accept_encoding.size();
+        }
+
+        // Nom du codage, espaces exclus
+        size_t name_start = accept_encoding.find_first_not_of(" \t", pos);
+        size_t name_end = name_start;
+        while (name_end < end && accept_encoding[name_end] != ';'
+               && accept_encoding[name_end] != ' ' && accept_encoding[name_end] != '\t') {
+            name_end++;
+        }
+
+        // Qualité : 1 par défaut
+        double quality = 1;
+        size_t q = accept_encoding.find("q=", name_end);
+        if (q != std::string::npos && q < end) {
+            quality = atof(accept_encoding.c_str() + q + 2);
+        }
+
+        if (name_start < end) {
+            size_t name_len = name_end - name_start;
+            if (name_len == coding_len
+                && strncasecmp(accept_encoding.c_str() + name_start, coding, coding_len) == 0) {
+                return quality > 0;
+            }
+            if (name_len == 1 && accept_encoding[name_start] == '*') {
+                wildcard = quality;
+            }
+        }
+        pos = end + 1;
+    }
+    return wildcard > 0;
+}
+
+/**
+ * @brief Lit un nombre décimal entre pos et end
+ * @return false si la portion est vide, contient autre chose qu'un chiffre ou déborde
+ */
+static bool parseOffset(const std::string& str, size_t pos, size_t end, off_t& value) {
+    if (pos >= end) {
+        return false;
+    }
+    value = 0;
+    for (; pos < end; pos++) {
+        if (str[pos] < '0' || str[pos] > '9') {
+            return false;
+        }
+        off_t next = value * 10 + (str[pos] - '0');
+        if (next / 10 != value) {
+            return false; // Débordement
+        }
+        value = next;
+    }
+    return true;
+}
+
+static bool compareRanges(const ByteRange& a, const ByteRange& b) {
+    return a.first < b.first;
+}
+
+/**
+ * @brief En-tête ignoré : les plages déjà lues sont abandonnées
+ */
+static RangeResult ignoreRange(std::vector<ByteRange>& ranges) {
+    ranges.clear();
+    return RANGE_IGNORED;
+}
+
+/**
+ * @brief Analyse un en-tête Range et garde les plages satisfaisables
+ * 
+ * Une plage hors de la ressource est écartée ; un en-tête mal formé est
+ * ignoré en entier, comme le permet la RFC. Les plages qui se chevauchent
+ * ou se touchent sont fusionnées (RFC 9110 §14.3) : une requête
+ * "0-100, 50-200" ne fait pas envoyer deux fois les mêmes octets.
+ */
+RangeResult parseRange(const std::string& value, off_t size, std::vector<ByteRange>& ranges) {
+    ranges.clear();
+    if (value.size() < 6 || strncasecmp(value.c_str(), "bytes=", 6) != 0) {
+        return RANGE_IGNORED; // Seule l'unité "bytes" existe
+    }
+
+    size_t specs = 0;
+    size_t pos = 6;
+    while (pos <= value.size()) {
+        size_t end = value.find(',', pos);
+        if (end == std::string::npos) {
+            end = value.size();
+        }
+        size_t start = value.find_first_not_of(" \t", pos);
+        size_t stop = end;
+        while (stop > pos && (value[stop - 1] == ' ' || value[stop - 1] == '\t')) {
+            stop--;
+        }
+        pos = end + 1;
+        if (start == std::string::npos || start >= stop) {
+            continue; // Élément vide de la liste
+        }
+        if (++specs > MAX_BYTE_RANGES) {
+            return ignoreRange(ranges);
+        }
+
+        size_t dash = value.find('-', start);
+        if (dash == std::string::npos || dash >= stop) {
+            return ignoreRange(ranges);
+        }
+        ByteRange range;
+        if (dash == start) {
+            // "-N" : les N derniers octets
+            off_t suffix;
+            if (!parseOffset(value, dash + 1, stop, suffix)) {
+                return ignoreRange(ranges);
+            }
+            if (suffix == 0 || size == 0) {
+                continue;
+            }
+            range.first = suffix < size ? size - suffix : 0;
+            range.last = size - 1;
+        } else {
+            // "A-B" ou "A-" : B est ramené à la fin de la ressource
+            if (!parseOffset(value, start, dash, range.first)) {
+                return ignoreRange(ranges);
+            }
+            range.last = size - 1;
+            if (dash + 1 < stop) {
+                off_t last;
+                if (!parseOffset(value, dash + 1, stop, last) || last < range.first) {
+                    return ignoreRange(ranges);
+                }
+                if (last < range.last) {
+                    range.last = last;
+                }
+            }
+            if (range.first >= size) {
+                continue;
+            }
+        }
+        ranges.push_back(range);
+    }
+
+    if (ranges.empty()) {
+        return specs > 0 ? RANGE_UNSATISFIABLE : RANGE_IGNORED;
+    }
+
+    std::sort(ranges.begin(), ranges.end(), compareRanges);
+    size_t merged = 0;
+    for (size_t i = 1; i < ranges.size(); i++) {
+        if (ranges[i].first <= ranges[merged].last + 1) {
+            ranges[merged].last = std::max(ranges[merged].last, ranges[i].last);
+        } else {
+            ranges[++merged] = ranges[i];
+        }
+    }
+    ranges.resize(merged + 1);
+    return RANGE_SATISFIABLE;
+}
+
 } // namespace HttpStringUtils 
\ No newline at end of file
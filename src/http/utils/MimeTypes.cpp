@@ -0,0 +1,185 @@
+#include "http/utils/MimeTypes.hpp"
+#include <cstring>
+
+std::vector<MimeTypes::Slot> MimeTypes::slots;
+std::deque<std::string> MimeTypes::types;
+size_t MimeTypes::used = 0;
+
+// Types intégrés, extensions sans le point
+static const struct {
+    const char* extension;
+    const char* type;
+} BUILTIN_TYPES[] = {
+    // Types texte - affichés dans le navigateur
+    { "html", "text/html" },
+    { "htm", "text/html" },
+    { "css", "text/css" },
+    { "txt", "text/plain" },
+    { "md", "text/plain" },
+    { "conf", "text/plain" },
+    { "csv", "text/plain" },
+    { "log", "text/plain" },
+
+    // Applications qui s'affichent dans le navigateur
+    { "json", "application/json" },
+    { "xml", "application/xml" },
+    { "js", "application/javascript" },
+
+    // Images - généralement affichées dans le navigateur
+    { "jpg", "image/jpeg" },
+    { "jpeg", "image/jpeg" },
+    { "png", "image/png" },
+    { "gif", "image/gif" },
+    { "svg", "image/svg+xml" },
+    { "ico", "image/x-icon" },
+
+    // Applications généralement téléchargées
+    { "pdf", "application/pdf" },
+    { "zip", "application/zip" },
+    { "gz", "application/gzip" },
+    { "tar", "application/x-tar" },
+
+    // Médias
+    { "mp3", "audio/mpeg" },
+    { "mp4", "video/mp4" },
+    { "mpeg", "video/mpeg" },
+    { "avi", "video/x-msvideo" },
+    { "webm", "video/webm" },
+    { "wav", "audio/wav" },
+    { "ogg", "audio/ogg" },
+
+    // Polices
+    { "woff", "font/woff" },
+    { "woff2", "font/woff2" },
+    { "ttf", "font/ttf" },
+    { "otf", "font/otf" },
+    { "eot", "application/vnd.ms-fontobject" },
+
+    // CGI
+    { "php", "text/html" } // PHP sera traité par CGI
+};
+
+const std::string& MimeTypes::defaultType() {
+    static const std::string default_type("application/octet-stream");
+    return default_type;
+}
+
+/**
+ * @brief Remplit la table avec les types intégrés (premier appel seulement)
+ */
+void MimeTypes::initialize() {
+    if (!slots.empty()) {
+        return;
+    }
+    slots.resize(128);
+    for (size_t i = 0; i < sizeof(BUILTIN_TYPES) / sizeof(BUILTIN_TYPES[0]); i++) {
+        add(BUILTIN_TYPES[i].extension, BUILTIN_TYPES[i].type);
+    }
+}
+
+/**
+ * @brief FNV-1a
+ */
+unsigned long MimeTypes::hash(const char* extension, size_t length) {
+    unsigned long h = 2166136261UL;
+    for (size_t i = 0; i < length; i++) {
+        h = (h ^ static_cast<unsigned char>(extension[i])) * 16777619UL;
+    }
+    return h;
+}
+
+/**
+ * @brief Case de l'extension, ou case libre où l'insérer (sondage linéaire)
+ */
+MimeTypes::Slot* MimeTypes::find(const char* extension, size_t length) {
+    size_t mask = slots.size() - 1;
+    for (size_t i = hash(extension, length) & mask; ; i = (i + 1) & mask) {
+        Slot& slot = slots[i];
+        if (slot.length == 0 || (slot.length == length && memcmp(slot.extension, extension, length) == 0)) {
+            return &slot;
+        }
+    }
+}
+
+void MimeTypes::insert(const char* extension, size_t length, const std::string* type) {
+    Slot* slot = find(extension, length);
+    if (slot->length == 0) {
+        memcpy(slot->extension, extension, length);
+        slot->extension[length] = '\0';
+        slot->length = length;
+        used++;
+    }
+    slot->type = type;
+}
+
+/**
+ * @brief Double la table pour qu'elle reste remplie au plus à moitié
+ */
+void MimeTypes::grow() {
+    std::vector<Slot> old;
+    old.swap(slots);
+    slots.resize(old.size() * 2);
+    used = 0;
+    for (size_t i = 0; i < old.size(); i++) {
+        if (old[i].length > 0) {
+            insert(old[i].extension, old[i].length, old[i].type);
+        }
+    }
+}
+
+/**
+ * @brief Chaîne unique par type : plusieurs extensions partagent la même
+ */
+const std::string* MimeTypes::intern(const std::string& type) {
+    for (size_t i = 0; i < types.size(); i++) {
+        if (types[i] == type) {
+            return &types[i];
+        }
+    }
+    types.push_back(type);
+    return &types.back();
+}
+
+bool MimeTypes::add(const std::string& extension, const std::string& type) {
+    initialize();
+    size_t start = !extension.empty() && extension[0] == '.' ? 1 : 0;
+    size_t length = extension.size() - start;
+    if (length == 0 || length > MIME_MAX_EXTENSION) {
+        return false;
+    }
+
+    char lower[MIME_MAX_EXTENSION + 1];
+    for (size_t i = 0; i < length; i++) {
+        char c = extension[start + i];
+        lower[i] = c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c;
+    }
+    if ((used + 1) * 2 > slots.size()) {
+        grow();
+    }
+    insert(lower, length, intern(type));
+    return true;
+}
+
+/**
+ * @brief Recherche sans allocation : extension copiée en minuscules sur la pile
+ */
+const std::string& MimeTypes::lookup(const std::string& file_path) {
+    initialize();
+    size_t dot = file_path.find_last_of("./");
+    if (dot == std::string::npos || file_path[dot] != '.') {
+        return defaultType(); // Pas d'extension dans le dernier composant
+    }
+    size_t length = file_path.size() - dot - 1;
+    if (length == 0 || length > MIME_MAX_EXTENSION) {
+        return defaultType();
+    }
+
+    char lower[MIME_MAX_EXTENSION + 1];
+    const char* extension = file_path.data() + dot + 1;
+    for (size_t i = 0; i < length; i++) {
+        char c = extension[i];
+        lower[i] = c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c;
+    }
+    Slot* slot = find(lower, length);
+    return slot->length > 0 ? *slot->type : defaultType();
+}
@@ -0,0 +1,110 @@
+#include "http/utils/OpenFileCache.hpp"
+#include "http/utils/HttpDate.hpp"
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+OpenFileCache::OpenFileCache(size_t max_entries, unsigned long valid_ms)
+    : max_entries(max_entries)
+    , valid_ms(valid_ms)
+    , hits(0)
+    , misses(0) {}
+
+/**
+ * @brief Horloge grossière (tick du noyau) : lue sans appel système réel
+ */
+unsigned long OpenFileCache::nowMs() {
+    struct timespec ts;
+#ifdef CLOCK_MONOTONIC_COARSE
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+#else
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#endif
+    return ts.tv_sec * 1000UL + ts.tv_nsec / 1000000;
+}
+
+/**
+ * @brief Ouvre le chemin et en lit les métadonnées avec un seul fstat()
+ *
+ * Le fd n'est conservé que pour un fichier régulier ; un chemin existant
+ * mais illisible (EACCES) est décrit par stat() avec readable à false.
+ */
+void OpenFileCache::load(const std::string& path, FileInfo& info) {
+    info = FileInfo();
+    struct stat st;
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC | O_NONBLOCK);
+    if (fd >= 0) {
+        if (fstat(fd, &st) != 0) {
+            close(fd);
+            return;
+        }
+        info.readable = true;
+    } else if (stat(path.c_str(), &st) != 0) {
+        return;
+    }
+
+    info.exists = true;
+    info.is_directory = S_ISDIR(st.st_mode);
+    info.is_regular = S_ISREG(st.st_mode);
+    info.size = st.st_size;
+    info.mtime = st.st_mtime;
+    info.inode = st.st_ino;
+    info.last_modified = HttpDate::format(st.st_mtime);
+
+    if (fd >= 0) {
+        if (info.is_regular) {
+            // O_NONBLOCK ne servait qu'à ne pas bloquer sur une FIFO
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+            info.file = FileHandle(fd);
+        } else {
+            close(fd);
+        }
+    }
+}
+
+bool OpenFileCache::lookup(const std::string& path, FileInfo& info) {
+    std::map<std::string, EntryList::iterator>::iterator it = index.find(path);
+    if (it != index.end()) {
+        EntryList::iterator entry = it->second;
+        if (nowMs() - entry->loaded_ms < valid_ms) {
+            hits++;
+            entries.splice(entries.begin(), entries, entry); // Devient le plus récent
+            info = entry->info;
+            return true;
+        }
+        // Entrée expirée : rechargée ci-dessous
+        entries.erase(entry);
+        index.erase(it);
+    }
+
+    misses++;
+    load(path, info);
+    if (!info.exists || max_entries == 0) {
+        return info.exists;
+    }
+
+    if (index.size() >= max_entries) {
+        index.erase(entries.back().path); // Le moins récemment utilisé, fd fermé avec lui
+        entries.pop_back();
+    }
+    Entry entry;
+    entry.path = path;
+    entry.info = info;
+    entry.loaded_ms = nowMs();
+    entries.push_front(entry);
+    index[path] = entries.begin();
+    return true;
+}
+
+void OpenFileCache::invalidate(const std::string& path) {
+    std::map<std::string, EntryList::iterator>::iterator it = index.find(path);
+    if (it != index.end()) {
+        entries.erase(it->second);
+        index.erase(it);
+    }
+}
+
+void OpenFileCache::clear() {
+    entries.clear();
+    index.clear();
+}
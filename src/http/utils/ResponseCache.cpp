@@ -0,0 +1,195 @@
+#include "http/utils/ResponseCache.hpp"
+#include "http/HttpResponse.hpp"
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+
+// Changements d'un fichier surveillé ou du répertoire lui-même
+#define WATCH_MASK (IN_MODIFY | IN_ATTRIB | IN_CLOSE_WRITE | IN_CREATE | IN_DELETE \
+                    | IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF)
+
+ResponseCache::ResponseCache(size_t max_entries, size_t max_file_size)
+    : max_entries(max_entries)
+    , max_file_size(max_file_size)
+    , watch_fd(-1)
+    , hits(0)
+    , misses(0) {}
+
+ResponseCache::~ResponseCache() {
+    if (watch_fd >= 0) {
+        close(watch_fd);
+    }
+}
+
+bool ResponseCache::start() {
+    if (max_entries == 0 || watch_fd >= 0) {
+        return enabled();
+    }
+    // Sans invalidation possible, rien n'est mis en cache
+    watch_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    return enabled();
+}
+
+bool ResponseCache::lookup(const std::string& path, SharedBuffer& response) {
+    if (!enabled()) {
+        return false;
+    }
+    std::map<std::string, EntryList::iterator>::iterator it = index.find(path);
+    if (it == index.end()) {
+        misses++;
+        return false;
+    }
+    hits++;
+    entries.splice(entries.begin(), entries, it->second); // Devient la plus récente
+    response = it->second->response;
+    return true;
+}
+
+/**
+ * @brief Retient la réponse une fois le répertoire du fichier surveillé
+ *
+ * Le fichier peut avoir changé avant la pose du watch (les métadonnées
+ * viennent du cache des fichiers ouverts) : il est comparé par stat() aux
+ * métadonnées de la réponse, ce qui ne coûte qu'un appel par mise en cache.
+ */
+bool ResponseCache::store(const std::string& path, const std::string& file_path,
+                          const FileInfo& info, const HttpResponse& response) {
+    // Body fichier, ou déjà en mémoire (version compressée à la volée, partagée)
+    size_t body_length = response.hasFileBody() ? response.getFileLength()
+                       : response.hasSharedBody() ? response.getSharedBody().size() : response.getBody().size();
+    if (!enabled() || response.getStatus() != 200 || response.hasPrebuilt() || body_length > max_file_size) {
+        return false;
+    }
+
+    size_t slash = file_path.find_last_of('/');
+    std::string dir = slash == std::string::npos ? "." : file_path.substr(0, slash + 1);
+    int wd = inotify_add_watch(watch_fd, dir.c_str(), WATCH_MASK);
+    if (wd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (stat(file_path.c_str(), &st) != 0 || st.st_ino != info.inode
+        || st.st_size != info.size || st.st_mtime != info.mtime) {
+        return false;
+    }
+
+    std::string built = response.buildPrebuilt();
+    if (built.size() < body_length + 4
+        || built.compare(built.size() - body_length - 4, 4, "\r\n\r\n") != 0) {
+        return false; // Fichier tronqué pendant la lecture
+    }
+
+    std::vector<std::string> evicted;
+    std::map<std::string, EntryList::iterator>::iterator it = index.find(path);
+    if (it != index.end()) {
+        erase(it->second, evicted);
+    } else if (index.size() >= max_entries) {
+        erase(--entries.end(), evicted); // La moins récemment utilisée
+    }
+
+    Entry entry;
+    entry.path = path;
+    entry.file_path = file_path;
+    entry.name = slash == std::string::npos ? file_path : file_path.substr(slash + 1);
+    // Une variante précompressée dépend aussi du fichier d'origine (et inversement)
+    size_t dot = entry.name.find_last_of('.');
+    if (dot != std::string::npos && (entry.name.compare(dot, std::string::npos, ".gz") == 0
+                                     || entry.name.compare(dot, std::string::npos, ".br") == 0)) {
+        entry.name.erase(dot);
+    }
+    entry.wd = wd;
+    entries.push_front(entry);
+    entries.front().response = SharedBuffer(built);
+    index[path] = entries.begin();
+    return true;
+}
+
+/**
+ * @brief Applique les événements inotify accumulés depuis le dernier réveil
+ *
+ * Un événement sur le répertoire lui-même (suppression, renommage) ou un
+ * débordement de la file d'événements invalide toutes les entrées concernées.
+ */
+void ResponseCache::processEvents(std::vector<std::string>& invalidated) {
+    if (!enabled()) {
+        return;
+    }
+    char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    while (true) {
+        ssize_t n = read(watch_fd, buffer, sizeof(buffer));
+        if (n <= 0) {
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            return; // EAGAIN : plus rien en attente
+        }
+
+        for (ssize_t pos = 0; pos < n; ) {
+            const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(buffer + pos);
+            pos += sizeof(struct inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW) {
+                // Événements perdus : plus aucune entrée n'est sûre
+                while (!entries.empty()) {
+                    erase(entries.begin(), invalidated);
+                }
+                continue;
+            }
+            bool whole_dir = (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) != 0;
+            std::string name = event->len > 0 ? std::string(event->name) : std::string();
+            for (EntryList::iterator entry = entries.begin(); entry != entries.end(); ) {
+                EntryList::iterator current = entry++;
+                if (current->wd == event->wd && (whole_dir || concerns(*current, name))) {
+                    erase(current, invalidated);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Un nom de fichier touche l'entrée s'il s'agit du fichier ou d'une variante (foo.css, foo.css.gz)
+ */
+bool ResponseCache::concerns(const Entry& entry, const std::string& name) {
+    return name.compare(0, entry.name.size(), entry.name) == 0
+        && (name.size() == entry.name.size() || name[entry.name.size()] == '.');
+}
+
+void ResponseCache::erase(EntryList::iterator entry, std::vector<std::string>& invalidated) {
+    invalidated.push_back(entry->file_path);
+    index.erase(entry->path);
+    entries.erase(entry);
+}
+
+/**
+ * @brief Retire sans attendre inotify toutes les entrées servies à partir de ce fichier
+ *
+ * Comme pour un événement : toutes les représentations (clés suffixées par
+ * le codage) et les variantes précompressées du fichier sont concernées.
+ */
+void ResponseCache::invalidate(const std::string& file_path, std::vector<std::string>& invalidated) {
+    size_t slash = file_path.find_last_of('/');
+    std::string dir = slash == std::string::npos ? std::string() : file_path.substr(0, slash + 1);
+    std::string name = slash == std::string::npos ? file_path : file_path.substr(slash + 1);
+    for (EntryList::iterator entry = entries.begin(); entry != entries.end(); ) {
+        EntryList::iterator current = entry++;
+        bool same_dir = current->file_path.compare(0, dir.size(), dir) == 0
+            && current->file_path.find('/', dir.size()) == std::string::npos;
+        if (current->file_path == file_path || current->path == file_path
+            || (same_dir && concerns(*current, name))) {
+            erase(current, invalidated);
+        }
+    }
+}
+
+void ResponseCache::clear() {
+    entries.clear();
+    index.clear();
+}
+
+double ResponseCache::hitRatio() const {
+    unsigned long lookups = hits + misses;
+    return lookups ? static_cast<double>(hits) / lookups : 0.0;
+}
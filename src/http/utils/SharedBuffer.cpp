@@ -0,0 +1,39 @@
+#include "http/utils/SharedBuffer.hpp"
+
+SharedBuffer::SharedBuffer() : shared(NULL) {}
+
+SharedBuffer::SharedBuffer(std::string& data) : shared(new Shared) {
+    shared->data.swap(data);
+    shared->refs = 1;
+}
+
+SharedBuffer::SharedBuffer(const SharedBuffer& other) : shared(other.shared) {
+    if (shared) {
+        shared->refs++;
+    }
+}
+
+SharedBuffer& SharedBuffer::operator=(const SharedBuffer& other) {
+    if (shared != other.shared) {
+        reset();
+        shared = other.shared;
+        if (shared) {
+            shared->refs++;
+        }
+    }
+    return *this;
+}
+
+SharedBuffer::~SharedBuffer() {
+    reset();
+}
+
+/**
+ * @brief Abandonne la référence ; le tampon est libéré par le dernier détenteur
+ */
+void SharedBuffer::reset() {
+    if (shared && --shared->refs == 0) {
+        delete shared;
+    }
+    shared = NULL;
+}
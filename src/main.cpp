@@ -1,5 +1,6 @@
 #include "Server.hpp"
 #include "MultiServerManager.hpp"
+#include "MasterProcess.hpp"
 #include "utils/Common.hpp"
 #include "config/ConfigParser.hpp"
 #include <iostream>
@@ -27,6 +28,12 @@ int main(int argc, char *argv[]) {
 		LOG_ERROR("Configuration error: " << e.what());
 		return 1;
 	}	
+	// Mode multi-workers : le maître fork les workers et les supervise
+	if (config.worker_processes != 1) {
+		MasterProcess master(config);
+		return master.run();
+	}
+
 	// Initialiser et gérer les serveurs
 	MultiServerManager server_manager;
 	
@@ -0,0 +1,228 @@
+#include "socket/OutboundQueue.hpp"
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/sendfile.h>
+#include <cstring>
+#include <cerrno>
+
+OutboundQueue::OutboundQueue()
+    : offset(0)
+    , pending(0)
+    , response_count(0) {
+}
+
+/**
+ * @brief Ajoute des données en fin de file sans les copier
+ */
+void OutboundQueue::enqueue(std::string& data) {
+    if (data.empty()) {
+        return;
+    }
+    pending += data.size();
+    chunks.push_back(Chunk());
+    chunks.back().head.swap(data);
+}
+
+/**
+ * @brief Ajoute une réponse préconstruite derrière headerBuffer() : seule une référence est prise
+ */
+void OutboundQueue::enqueueResponse(const SharedBuffer& data) {
+    pending += data.size();
+    pushChunk().shared = data;
+}
+
+/**
+ * @brief Tampon d'en-têtes réutilisable, vidé
+ */
+std::string& OutboundQueue::headerBuffer() {
+    header_buffer.clear();
+    return header_buffer;
+}
+
+/**
+ * @brief Ajoute une réponse sans copier ni ses en-têtes ni son body
+ * 
+ * Le tampon d'en-têtes part avec la réponse ; il est remplacé par la
+ * capacité récupérée sur la dernière réponse envoyée.
+ */
+void OutboundQueue::enqueueResponse(std::string& body) {
+    if (header_buffer.empty() && body.empty()) {
+        return;
+    }
+    pending += body.size();
+    pushChunk().body.swap(body);
+}
+
+/**
+ * @brief Ajoute une réponse dont le body est lu dans un fichier ouvert
+ */
+void OutboundQueue::enqueueResponse(const FileHandle& file, off_t offset, size_t length) {
+    Chunk& chunk = pushChunk();
+    if (length > 0) {
+        chunk.file = file;
+        chunk.file_offset = offset;
+        chunk.file_left = length;
+        pending += length;
+    }
+}
+
+/**
+ * @brief Marque le dernier élément ajouté comme fin de réponse
+ * 
+ * La réponse est décomptée quand cet élément est retiré de la file.
+ */
+void OutboundQueue::endResponse() {
+    if (chunks.empty() || chunks.back().ends_response) {
+        return; // Réponse vide, rien n'a été ajouté
+    }
+    chunks.back().ends_response = true;
+    response_count++;
+}
+
+/**
+ * @brief Ajoute un élément portant les en-têtes de headerBuffer()
+ */
+OutboundQueue::Chunk& OutboundQueue::pushChunk() {
+    pending += header_buffer.size();
+    chunks.push_back(Chunk());
+    chunks.back().head.swap(header_buffer);
+    header_buffer.swap(spare_header);
+    return chunks.back();
+}
+
+/**
+ * @brief Envoie autant de données que le socket en accepte sans bloquer
+ * @return FLUSH_DONE si la file est vide, FLUSH_AGAIN si le socket est plein,
+ *         FLUSH_ERROR en cas d'erreur
+ */
+OutboundQueue::FlushResult OutboundQueue::flush(int fd) {
+    while (!chunks.empty()) {
+        if (offset >= chunks.front().memorySize() && chunks.front().file_left == 0) {
+            popFront();
+            continue;
+        }
+        FlushResult result = offset < chunks.front().memorySize() ? sendMemory(fd) : sendFile(fd);
+        if (result != FLUSH_DONE) {
+            return result;
+        }
+    }
+    return FLUSH_DONE;
+}
+
+/**
+ * @brief Envoie les données en mémoire des premiers éléments en un seul appel
+ * 
+ * En-têtes et bodies des réponses en attente sont passés au noyau sans
+ * être concaténés au préalable. Le regroupement s'arrête après un élément
+ * qui a un body fichier : celui-ci doit partir avant la réponse suivante.
+ * @return FLUSH_DONE si tout ce qui a été présenté est parti
+ */
+OutboundQueue::FlushResult OutboundQueue::sendMemory(int fd) {
+    struct iovec iov[MAX_FLUSH_IOVECS];
+    int count = 0;
+    size_t skip = offset;
+    for (std::deque<Chunk>::const_iterator it = chunks.begin();
+         it != chunks.end() && count + 3 <= MAX_FLUSH_IOVECS; ++it) {
+        const char* parts[3] = { it->head.data(), it->body.data(), it->shared.data() };
+        size_t sizes[3] = { it->head.size(), it->body.size(), it->shared.size() };
+        for (int p = 0; p < 3; p++) {
+            if (skip >= sizes[p]) {
+                skip -= sizes[p];
+                continue;
+            }
+            iov[count].iov_base = const_cast<char*>(parts[p] + skip);
+            iov[count].iov_len = sizes[p] - skip;
+            skip = 0;
+            count++;
+        }
+        if (it->file_left > 0) {
+            break;
+        }
+    }
+
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = count;
+    ssize_t sent = sendmsg(fd, &msg, MSG_NOSIGNAL);
+
+    if (sent < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return FLUSH_AGAIN;
+        }
+        return errno == EINTR ? FLUSH_DONE : FLUSH_ERROR;
+    }
+
+    // Retirer les éléments envoyés en entier
+    size_t remaining = static_cast<size_t>(sent);
+    pending -= remaining;
+    while (remaining > 0) {
+        size_t chunk_left = chunks.front().memorySize() - offset;
+        if (remaining < chunk_left) {
+            offset += remaining;
+            return FLUSH_AGAIN; // Envoi partiel : le buffer du socket est plein
+        }
+        remaining -= chunk_left;
+        offset += chunk_left;
+        if (chunks.front().file_left > 0) {
+            break; // Reste le body fichier de cet élément
+        }
+        popFront();
+    }
+    return FLUSH_DONE;
+}
+
+/**
+ * @brief Envoie une tranche du body fichier du premier élément
+ * 
+ * sendfile() copie du cache de pages vers le socket sans passer par
+ * l'espace utilisateur ; les tranches laissent les autres clients être
+ * servis entre deux appels.
+ */
+OutboundQueue::FlushResult OutboundQueue::sendFile(int fd) {
+    Chunk& chunk = chunks.front();
+    size_t slice = chunk.file_left < SENDFILE_SLICE ? chunk.file_left : SENDFILE_SLICE;
+    ssize_t sent = sendfile(fd, chunk.file.fd(), &chunk.file_offset, slice);
+
+    if (sent < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return FLUSH_AGAIN;
+        }
+        return errno == EINTR ? FLUSH_DONE : FLUSH_ERROR;
+    }
+    if (sent == 0) {
+        return FLUSH_ERROR; // Fichier tronqué : Content-Length ne peut plus être tenu
+    }
+
+    chunk.file_left -= sent;
+    pending -= sent;
+    if (chunk.file_left == 0) {
+        popFront();
+    }
+    return FLUSH_DONE;
+}
+
+/**
+ * @brief Retire le premier élément en gardant la capacité de ses en-têtes
+ */
+void OutboundQueue::popFront() {
+    std::string& head = chunks.front().head;
+    if (head.capacity() > spare_header.capacity()) {
+        spare_header.swap(head);
+    }
+    if (chunks.front().ends_response) {
+        response_count--;
+    }
+    chunks.pop_front();
+    offset = 0;
+}
+
+/**
+ * @brief Abandonne toutes les données en attente
+ */
+void OutboundQueue::clear() {
+    chunks.clear();
+    offset = 0;
+    pending = 0;
+    response_count = 0;
+}
@@ -77,6 +77,13 @@ void Socket::setReuseAddr(bool reuse) {
     }
 }
 
+void Socket::setReusePort(bool reuse) {
+    int opt = reuse ? 1 : 0;
+    if (setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt)) < 0) {
+        throw std::runtime_error("Failed to set SO_REUSEPORT: " + std::string(strerror(errno)));
+    }
+}
+
 ssize_t Socket::send(const std::string& data) {
     return ::send(fd, data.c_str(), data.length(), 0);
 }
@@ -0,0 +1,176 @@
+#include "http/HttpRequest.hpp"
+#include "http/parser/RequestParser.hpp"
+#include "utils/Common.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <sstream>
+#include <string>
+#include <sys/time.h>
+
+/*
+ * Micro-benchmark du parsing des requêtes HTTP.
+ *
+ * Compare l'ancien parser (substr + istringstream + getline + std::map,
+ * reproduit ci-dessous à l'identique) au RequestParser incrémental, sur une
+ * requête complète et sur une requête reçue par morceaux de 64 octets.
+ */
+
+static const char* SAMPLE_REQUEST =
+    "GET /images/photos/2024/summer/beach.jpg?size=large&format=webp HTTP/1.1\r\n"
+    "Host: www.example.com:8080\r\n"
+    "User-Agent: Mozilla/5.0 (X11; Linux x86_64; rv:124.0) Gecko/20100101 Firefox/124.0\r\n"
+    "Accept: image/avif,image/webp,*/*\r\n"
+    "Accept-Language: fr-FR,fr;q=0.8,en-US;q=0.5,en;q=0.3\r\n"
+    "Accept-Encoding: gzip, deflate, br\r\n"
+    "Referer: http://www.example.com:8080/gallery/summer.html\r\n"
+    "Connection: keep-alive\r\n"
+    "Cookie: session_id=4f9a1c2e7b3d; theme=dark; lang=fr\r\n"
+    "Sec-Fetch-Dest: image\r\n"
+    "Sec-Fetch-Mode: no-cors\r\n"
+    "Sec-Fetch-Site: same-origin\r\n"
+    "If-None-Match: \"5f2b-64a1c3e0\"\r\n"
+    "Cache-Control: max-age=0\r\n"
+    "\r\n";
+
+// Ancien HttpRequest::parse(), limité à la ligne de requête et aux en-têtes
+struct LegacyRequest {
+    std::string method;
+    std::string uri;
+    std::string version;
+    std::map<std::string, std::string> headers;
+    std::string body;
+};
+
+static bool legacyParse(const std::string& raw_request, LegacyRequest& req) {
+    req.headers.clear();
+    req.body.clear();
+
+    size_t pos = raw_request.find("\r\n");
+    if (pos == std::string::npos) {
+        return false;
+    }
+
+    std::istringstream line(raw_request.substr(0, pos));
+    if (!(line >> req.method >> req.uri >> req.version)) {
+        return false;
+    }
+
+    size_t body_start = raw_request.find("\r\n\r\n");
+    if (body_start == std::string::npos) {
+        return false;
+    }
+
+    std::istringstream iss(raw_request.substr(pos + 2, body_start - pos - 2));
+    std::string header;
+    while (std::getline(iss, header)) {
+        if (!header.empty() && header[header.length() - 1] == '\r') {
+            header.erase(header.length() - 1);
+        }
+        if (header.empty()) {
+            continue;
+        }
+        size_t colon = header.find(": ");
+        if (colon == std::string::npos) {
+            return false;
+        }
+        std::string name = header.substr(0, colon);
+        std::string value = header.substr(colon + 2);
+        std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+        req.headers[name] = value;
+    }
+
+    if (body_start + 4 < raw_request.length()) {
+        req.body = raw_request.substr(body_start + 4);
+    }
+    return true;
+}
+
+static double nowSeconds() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+static void report(const char* name, size_t iterations, double elapsed, double baseline) {
+    double rate = iterations / elapsed;
+    if (baseline > 0) {
+        printf("  %-42s %12.0f req/s  (x%.2f)\n", name, rate, rate / baseline);
+    } else {
+        printf("  %-42s %12.0f req/s\n", name, rate);
+    }
+}
+
+int main(int argc, char** argv) {
+    const size_t iterations = argc > 1 ? static_cast<size_t>(atol(argv[1])) : 200000;
+    const std::string raw(SAMPLE_REQUEST);
+    const size_t chunk = 64;
+    size_t checksum = 0;
+
+    printf("Requête de %lu octets, %lu itérations\n\n", (unsigned long)raw.size(), (unsigned long)iterations);
+
+    // 1. Requête complète
+    printf("Requête complète :\n");
+    double start = nowSeconds();
+    LegacyRequest legacy;
+    for (size_t i = 0; i < iterations; i++) {
+        legacyParse(raw, legacy);
+        checksum += legacy.headers.size();
+    }
+    double legacy_rate = iterations / (nowSeconds() - start);
+    report("ancien parser (substr/istringstream/map)", iterations, iterations / legacy_rate, 0);
+
+    RequestParser parser;
+    start = nowSeconds();
+    for (size_t i = 0; i < iterations; i++) {
+        parser.reset();
+        parser.feed(raw.data(), raw.size());
+        checksum += parser.getHeaders().size();
+    }
+    report("RequestParser (spans seuls)", iterations, nowSeconds() - start, legacy_rate);
+
+    HttpRequest request;
+    start = nowSeconds();
+    for (size_t i = 0; i < iterations; i++) {
+        parser.reset();
+        parser.feed(raw.data(), raw.size());
+        request.parse(raw.data(), raw.size(), parser);
+        checksum += request.getHeaders().size();
+    }
+    report("RequestParser + HttpRequest", iterations, nowSeconds() - start, legacy_rate);
+
+    // 2. Requête reçue par morceaux : l'ancien code rescannait tout le tampon
+    //    à chaque recv() pour trouver \r\n\r\n avant de parser
+    printf("\nRequête reçue par morceaux de %lu octets :\n", (unsigned long)chunk);
+    std::string buffer;
+    buffer.reserve(raw.size());
+    start = nowSeconds();
+    for (size_t i = 0; i < iterations; i++) {
+        buffer.clear();
+        for (size_t off = 0; off < raw.size(); off += chunk) {
+            buffer.append(raw, off, chunk);
+            if (buffer.find("\r\n\r\n") != std::string::npos) {
+                legacyParse(buffer, legacy);
+            }
+        }
+        checksum += legacy.headers.size();
+    }
+    legacy_rate = iterations / (nowSeconds() - start);
+    report("ancien parser (rescan + parse)", iterations, iterations / legacy_rate, 0);
+
+    start = nowSeconds();
+    for (size_t i = 0; i < iterations; i++) {
+        buffer.clear();
+        parser.reset();
+        for (size_t off = 0; off < raw.size(); off += chunk) {
+            buffer.append(raw, off, chunk);
+            parser.feed(buffer.data(), buffer.size());
+        }
+        checksum += parser.getHeaders().size();
+    }
+    report("RequestParser (reprise incrémentale)", iterations, nowSeconds() - start, legacy_rate);
+
+    printf("\n(checksum %lu)\n", (unsigned long)checksum);
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include "http/parser/ByteScanner.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <sys/time.h>
+
+/*
+ * Micro-benchmark de ByteScanner::findSequence.
+ *
+ * Compare std::string::find à la recherche vectorisée sur les boundaries
+ * d'un body multipart de plusieurs Mo. Les fins de ligne et ':' du parser
+ * restent cherchés par memchr() (glibc, déjà vectorisé) : rien à mesurer ici.
+ */
+
+static double nowSeconds() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+static void report(const char* name, double elapsed, double baseline) {
+    if (baseline > 0) {
+        printf("  %-42s %10.2f ms  (x%.2f)\n", name, elapsed * 1000, baseline / elapsed);
+    } else {
+        printf("  %-42s %10.2f ms\n", name, elapsed * 1000);
+    }
+}
+
+// Body multipart : parties binaires (avec des '-' et des \r\n) séparées par un boundary
+static std::string buildMultipart(const std::string& boundary, size_t parts, size_t part_size) {
+    std::string body;
+    srand(42);
+    for (size_t p = 0; p < parts; p++) {
+        body += "--" + boundary + "\r\n";
+        body += "Content-Disposition: form-data; name=\"file\"; filename=\"data.bin\"\r\n\r\n";
+        for (size_t i = 0; i < part_size; i++) {
+            int r = rand() % 64;
+            body += r == 0 ? '-' : r == 1 ? '\r' : r == 2 ? '\n' : static_cast<char>('a' + r % 26);
+        }
+        body += "\r\n";
+    }
+    return body + "--" + boundary + "--\r\n";
+}
+
+int main(int argc, char** argv) {
+    const size_t iterations = argc > 1 ? static_cast<size_t>(atol(argv[1])) : 20;
+    size_t checksum = 0;
+
+    printf("Implémentation : %s\n\n", ByteScanner::implementation());
+
+    const std::string boundary = "----WebKitFormBoundary7MA4YWxkTrZu0gW";
+    const std::string delimiter = "--" + boundary;
+    std::string body = buildMultipart(boundary, 16, 256 * 1024);
+    printf("Boundaries d'un body multipart de %lu octets (%lu itérations) :\n",
+           (unsigned long)body.size(), (unsigned long)iterations);
+
+    double start = nowSeconds();
+    for (size_t i = 0; i < iterations; i++) {
+        for (size_t pos = body.find(delimiter); pos != std::string::npos; pos = body.find(delimiter, pos + 1)) {
+            checksum += pos;
+        }
+    }
+    double baseline = nowSeconds() - start;
+    report("std::string::find", baseline, 0);
+
+    start = nowSeconds();
+    for (size_t i = 0; i < iterations; i++) {
+        for (size_t pos = ByteScanner::findSequence(body.data(), body.size(), 0, delimiter.data(), delimiter.size());
+             pos != std::string::npos;
+             pos = ByteScanner::findSequence(body.data(), body.size(), pos + 1, delimiter.data(), delimiter.size())) {
+            checksum += pos;
+        }
+    }
+    report("ByteScanner::findSequence", nowSeconds() - start, baseline);
+
+    printf("\n(checksum %lu)\n", (unsigned long)checksum);
+    return 0;
+}
@@ -41,6 +41,7 @@ void test_basic_config() {
          << "        index=index.html\n"
          << "        autoindex=off\n"
          << "        client_max_body_size=20M\n"
+         << "        gzip_static=on\n"
          << "    }\n"
          << "\n"
          << "    location /file-upload {\n"
@@ -77,12 +78,14 @@ void test_basic_config() {
     assert(root_location.index_files[0] == "index.html");
     assert(!root_location.autoindex);
     assert(root_location.client_max_body_size == 20 * 1024 * 1024); // 20M
+    assert(root_location.gzip_static);
 
     // Vérifier la location /upload
     LocationConfig upload_location = server.locations["/file-upload"];
     assert(upload_location.allowed_methods.size() == 1);
     assert(upload_location.allowed_methods[0] == "POST");
     assert(upload_location.client_max_body_size == 50 * 1024 * 1024); // 50M
+    assert(!upload_location.gzip_static);
 
     // Nettoyer
     std::remove(filename);
@@ -136,6 +139,124 @@ void test_multiple_servers() {
     LOG_SUCCESS("Test de configuration multiple réussi!");
 }
 
+// Test des directives de timeout et de pipelining
+void test_timeouts() {
+    LOG_INFO("Test des directives de timeout...");
+    
+    const char* filename = "test_timeouts.conf";
+    std::ofstream file(filename);
+    file << "server {\n"
+         << "    port=8080\n"
+         << "    host=127.0.0.1\n"
+         << "    client_header_timeout=10\n"
+         << "    client_body_timeout=15s\n"
+         << "    keepalive_timeout=500ms\n"
+         << "    send_timeout=2m\n"
+         << "    max_pipelined_requests=4\n"
+         << "    open_file_cache=128\n"
+         << "    open_file_cache_valid=20s\n"
+         << "    response_cache=16\n"
+         << "    response_cache_max_size=32K\n"
+         << "    gzip=on\n"
+         << "    gzip_comp_level=4\n"
+         << "    gzip_min_length=256\n"
+         << "}\n"
+         << "\n"
+         << "server {\n"
+         << "    port=8081\n"
+         << "    host=127.0.0.1\n"
+         << "}\n";
+    file.close();
+
+    ConfigParser parser;
+    WebservConfig config = parser.parseFile(filename);
+    assert(config.servers.size() == 2);
+
+    const ServerConfig& server = config.servers[0];
+    assert(server.client_header_timeout == 10000);
+    assert(server.client_body_timeout == 15000);
+    assert(server.keepalive_timeout == 500);
+    assert(server.send_timeout == 120000);
+    assert(server.max_pipelined_requests == 4);
+    assert(server.open_file_cache == 128);
+    assert(server.open_file_cache_valid == 20000);
+    assert(server.response_cache == 16);
+    assert(server.response_cache_max_size == 32 * 1024);
+    assert(server.gzip);
+    assert(server.gzip_comp_level == 4);
+    assert(server.gzip_min_length == 256);
+
+    // Valeurs par défaut
+    const ServerConfig& defaults = config.servers[1];
+    assert(defaults.client_header_timeout == 60000);
+    assert(defaults.keepalive_timeout == 75000);
+    assert(defaults.max_pipelined_requests == 32);
+    assert(defaults.open_file_cache == 0);
+    assert(defaults.open_file_cache_valid == 60000);
+    assert(defaults.response_cache == 0);
+    assert(!defaults.gzip);
+    assert(defaults.gzip_comp_level == 6);
+
+    std::remove(filename);
+    LOG_SUCCESS("Test des directives de timeout réussi!");
+}
+
+// Test des types MIME ajoutés par la configuration
+void test_mime_types() {
+    LOG_INFO("Test des types MIME...");
+
+    const char* types_file = "test_mime.types";
+    std::ofstream types(types_file);
+    types << "types {\n"
+          << "    text/markdown md markdown;\n"
+          << "    application/vnd.openxmlformats-officedocument.wordprocessingml.document\n"
+          << "        docx;\n"
+          << "}\n";
+    types.close();
+
+    const char* filename = "test_mime.conf";
+    std::ofstream file(filename);
+    file << "mime_types=test_mime.types\n"
+         << "types {\n"
+         << "    application/wasm wasm;\n"
+         << "    text/x-markdown MD # remplace le fichier\n"
+         << "}\n"
+         << "server {\n"
+         << "    port=8080\n"
+         << "    host=127.0.0.1\n"
+         << "}\n";
+    file.close();
+
+    ConfigParser parser;
+    WebservConfig config = parser.parseFile(filename);
+    assert(config.mime_types.size() == 4);
+    assert(config.mime_types["markdown"] == "text/markdown");
+    assert(config.mime_types["md"] == "text/x-markdown");
+    assert(config.mime_types["docx"] == "application/vnd.openxmlformats-officedocument.wordprocessingml.document");
+    assert(config.mime_types["wasm"] == "application/wasm");
+
+    // Déclaration sans extension
+    std::ofstream invalid(filename);
+    invalid << "types {\n"
+            << "    application/wasm;\n"
+            << "}\n"
+            << "server {\n"
+            << "    port=8080\n"
+            << "}\n";
+    invalid.close();
+    bool exception_thrown = false;
+    try {
+        parser.parseFile(filename);
+    } catch (const std::exception&) {
+        exception_thrown = true;
+    }
+    assert(exception_thrown);
+
+    std::remove(filename);
+    std::remove(types_file);
+    LOG_SUCCESS("Test des types MIME réussi!");
+}
+
 // Test de sélection de location
 void test_location_selection() {
     LOG_INFO("Test de sélection de location...");
@@ -337,6 +458,8 @@ int main() {
     try {
         test_basic_config();
         test_multiple_servers();
+        test_timeouts();
+        test_mime_types();
         test_location_selection();
         test_error_cases();
         
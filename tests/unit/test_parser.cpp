@@ -1,4 +1,5 @@
 #include "http/HttpRequest.hpp"
+#include "http/parser/ChunkedDecoder.hpp"
 #include "utils/Common.hpp"
 #include <iostream>
 
@@ -9,9 +10,9 @@ void printRequestInfo(const HttpRequest& req) {
     LOG_INFO("Version: " << req.getVersion());
     LOG_INFO("Query String: " << req.getQueryString());
     LOG_INFO("\nHeaders:");
-    for (std::map<std::string, std::string>::const_iterator it = req.getHeaders().begin();
-         it != req.getHeaders().end(); ++it) {
-        LOG_INFO(it->first << ": " << it->second);
+    const HttpHeaders& headers = req.getHeaders();
+    for (size_t i = 0; i < headers.size(); i++) {
+        LOG_INFO(headers[i].name << ": " << headers[i].value);
     }
     LOG_INFO("\nBody: " << req.getBody());
 }
@@ -72,5 +73,78 @@ int main() {
         LOG_ERROR("Error: Invalid request was accepted");
     }
     
+    // Test 5: Requête reçue octet par octet (parser incrémental)
+    LOG_INFO("\n=== Test 5: Requête reçue octet par octet ===");
+    RequestParser parser;
+    std::string buffer;
+    RequestParser::Result result = RequestParser::PARSE_AGAIN;
+    for (size_t i = 0; i < post_request.size() && result == RequestParser::PARSE_AGAIN; i++) {
+        buffer += post_request[i]; // Le tampon peut être réalloué entre deux appels
+        result = parser.feed(buffer.data(), buffer.size());
+    }
+    
+    if (result == RequestParser::PARSE_COMPLETE && buffer.size() == post_request.size()
+        && parser.getTarget().str(buffer.data()) == "/submit"
+        && parser.getContentLength() == 23
+        && request.parse(buffer.data(), buffer.size(), parser)
+        && request.getBody() == "username=john&pass=1234") {
+        LOG_SUCCESS("Successfully parsed request split at every byte");
+    } else {
+        LOG_ERROR("Error: Incremental parsing failed");
+    }
+    
+    // Test 6: Content-Length invalide
+    LOG_INFO("\n=== Test 6: Content-Length invalide ===");
+    std::string bad_length_request = 
+        "POST /submit HTTP/1.1\r\n"
+        "Content-Length: 12abc\r\n"
+        "\r\n";
+    
+    if (!request.parse(bad_length_request) && request.getErrorCode() == 400) {
+        LOG_SUCCESS("Successfully rejected invalid Content-Length");
+    } else {
+        LOG_ERROR("Error: Invalid Content-Length was accepted");
+    }
+    
+    // Test 7: Body chunked décodé octet par octet
+    LOG_INFO("\n=== Test 7: Body chunked reçu octet par octet ===");
+    std::string chunked_body = "4;ext=1\r\nWiki\r\n5\r\npedia\r\nE\r\n in\r\n\r\nchunks.\r\n0\r\nX-Trailer: 1\r\n\r\n";
+    ChunkedDecoder decoder;
+    std::string decoded;
+    std::string pending;
+    ChunkedDecoder::Result decode_result = ChunkedDecoder::DECODE_AGAIN;
+    for (size_t i = 0; i < chunked_body.size() && decode_result == ChunkedDecoder::DECODE_AGAIN; i++) {
+        pending += chunked_body[i];
+        size_t consumed = 0;
+        decode_result = decoder.decode(pending.data(), pending.size(), consumed, decoded);
+        pending.erase(0, consumed);
+    }
+    
+    std::string chunked_request =
+        "POST /submit HTTP/1.1\r\n"
+        "Transfer-Encoding: chunked\r\n"
+        "\r\n" + chunked_body;
+    if (decode_result == ChunkedDecoder::DECODE_DONE && pending.empty()
+        && decoded == "Wikipedia in\r\n\r\nchunks."
+        && request.parse(chunked_request) && request.getBody() == decoded) {
+        LOG_SUCCESS("Successfully decoded chunked body split at every byte");
+    } else {
+        LOG_ERROR("Error: Chunked decoding failed");
+    }
+    
+    // Test 8: Body chunked au-delà de la limite, refusé dès la taille du chunk
+    LOG_INFO("\n=== Test 8: Body chunked trop grand ===");
+    decoder.reset();
+    decoder.setMaxBodySize(8);
+    decoded.clear();
+    size_t consumed = 0;
+    std::string oversized = "5\r\nhello\r\n10\r\n";
+    if (decoder.decode(oversized.data(), oversized.size(), consumed, decoded) == ChunkedDecoder::DECODE_ERROR
+        && decoder.getErrorCode() == 413 && decoded == "hello") {
+        LOG_SUCCESS("Successfully rejected oversized chunked body with 413");
+    } else {
+        LOG_ERROR("Error: Oversized chunked body was accepted");
+    }
+    
     return 0;
 } 
\ No newline at end of file
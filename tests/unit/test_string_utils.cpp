@@ -0,0 +1,145 @@
+#include "http/utils/HttpStringUtils.hpp"
+#include "utils/Common.hpp"
+#include <cassert>
+#include <cstdio>
+#include <vector>
+
+using namespace HttpStringUtils;
+
+static bool hasRange(const std::vector<ByteRange>& ranges, size_t i, off_t first, off_t last) {
+    return i < ranges.size() && ranges[i].first == first && ranges[i].last == last;
+}
+
+// Plages simples, ouvertes et suffixes
+void test_range_forms() {
+    LOG_INFO("Test formes de Range...");
+    std::vector<ByteRange> ranges;
+
+    assert(parseRange("bytes=0-499", 1000, ranges) == RANGE_SATISFIABLE);
+    assert(ranges.size() == 1 && hasRange(ranges, 0, 0, 499));
+
+    // Fin ramenée à la taille de la ressource
+    assert(parseRange("bytes=900-5000", 1000, ranges) == RANGE_SATISFIABLE);
+    assert(hasRange(ranges, 0, 900, 999));
+    assert(parseRange("bytes=500-", 1000, ranges) == RANGE_SATISFIABLE);
+    assert(hasRange(ranges, 0, 500, 999));
+
+    // Suffixes : les N derniers octets, toute la ressource si N la dépasse
+    assert(parseRange("bytes=-200", 1000, ranges) == RANGE_SATISFIABLE);
+    assert(hasRange(ranges, 0, 800, 999));
+    assert(parseRange("bytes=-5000", 1000, ranges) == RANGE_SATISFIABLE);
+    assert(hasRange(ranges, 0, 0, 999));
+
+    // Unité insensible à la casse, espaces autour des éléments
+    assert(parseRange("Bytes= 0-9 ,  20-29 ", 1000, ranges) == RANGE_SATISFIABLE);
+    assert(ranges.size() == 2 && hasRange(ranges, 0, 0, 9) && hasRange(ranges, 1, 20, 29));
+    LOG_SUCCESS("Test formes de Range réussi!");
+}
+
+// Tri et fusion des plages qui se chevauchent ou se touchent
+void test_range_merge() {
+    LOG_INFO("Test fusion des plages...");
+    std::vector<ByteRange> ranges;
+
+    assert(parseRange("bytes=500-599,0-99,50-149", 1000, ranges) == RANGE_SATISFIABLE);
+    assert(ranges.size() == 2 && hasRange(ranges, 0, 0, 149) && hasRange(ranges, 1, 500, 599));
+
+    // Plages adjacentes : une seule partie
+    assert(parseRange("bytes=0-99,100-199", 1000, ranges) == RANGE_SATISFIABLE);
+    assert(ranges.size() == 1 && hasRange(ranges, 0, 0, 199));
+
+    // Un suffixe qui recouvre une plage explicite
+    assert(parseRange("bytes=950-959,-100", 1000, ranges) == RANGE_SATISFIABLE);
+    assert(ranges.size() == 1 && hasRange(ranges, 0, 900, 999));
+    LOG_SUCCESS("Test fusion des plages réussi!");
+}
+
+// Aucune plage dans la ressource : 416
+void test_range_unsatisfiable() {
+    LOG_INFO("Test plages non satisfaisables...");
+    std::vector<ByteRange> ranges;
+
+    assert(parseRange("bytes=1000-", 1000, ranges) == RANGE_UNSATISFIABLE);
+    assert(ranges.empty());
+    assert(parseRange("bytes=1500-1600", 1000, ranges) == RANGE_UNSATISFIABLE);
+    assert(parseRange("bytes=-0", 1000, ranges) == RANGE_UNSATISFIABLE);
+    assert(parseRange("bytes=0-10", 0, ranges) == RANGE_UNSATISFIABLE);
+
+    // Une seule plage satisfaisable suffit
+    assert(parseRange("bytes=2000-,10-19", 1000, ranges) == RANGE_SATISFIABLE);
+    assert(ranges.size() == 1 && hasRange(ranges, 0, 10, 19));
+    LOG_SUCCESS("Test plages non satisfaisables réussi!");
+}
+
+// En-tête invalide : ignoré, la ressource entière est servie
+void test_range_ignored() {
+    LOG_INFO("Test Range invalides...");
+    std::vector<ByteRange> ranges;
+    const char* invalid[] = {
+        "", "bytes", "bytes=", "items=0-10", "bytes=abc", "bytes=10", "bytes=20-10",
+        "bytes=0-10,x-y", "bytes=1-2-3", "bytes=--5", "bytes=0x10-20",
+        "bytes=99999999999999999999999-", NULL
+    };
+    for (size_t i = 0; invalid[i]; i++) {
+        assert(parseRange(invalid[i], 1000, ranges) == RANGE_IGNORED);
+        assert(ranges.empty());
+    }
+    LOG_SUCCESS("Test Range invalides réussi!");
+}
+
+// Au-delà de MAX_BYTE_RANGES éléments, l'en-tête est ignoré
+void test_range_limit() {
+    LOG_INFO("Test limite du nombre de plages...");
+    std::vector<ByteRange> ranges;
+    std::string value = "bytes=";
+    for (int i = 0; i < MAX_BYTE_RANGES; i++) {
+        char spec[32];
+        snprintf(spec, sizeof(spec), "%s%d-%d", i ? "," : "", i * 10, i * 10 + 4);
+        value += spec;
+    }
+    assert(parseRange(value, 10000, ranges) == RANGE_SATISFIABLE);
+    assert(ranges.size() == MAX_BYTE_RANGES);
+
+    value += ",5000-5001";
+    assert(parseRange(value, 10000, ranges) == RANGE_IGNORED);
+    assert(ranges.empty());
+    LOG_SUCCESS("Test limite du nombre de plages réussi!");
+}
+
+// Accept-Encoding : qualités, q=0 et "*"
+void test_accepts_encoding() {
+    LOG_INFO("Test Accept-Encoding...");
+    assert(acceptsEncoding("gzip, deflate, br", "gzip"));
+    assert(acceptsEncoding("deflate, br", "br"));
+    assert(!acceptsEncoding("deflate, br", "gzip"));
+    assert(!acceptsEncoding("", "gzip"));
+    assert(acceptsEncoding("GZIP", "gzip"));
+    assert(!acceptsEncoding("gzipx, xgzip", "gzip"));
+
+    // q=0 refuse explicitement le codage
+    assert(acceptsEncoding("gzip;q=0.5", "gzip"));
+    assert(acceptsEncoding("gzip; q=1.0, br;q=0", "gzip"));
+    assert(!acceptsEncoding("gzip;q=0", "gzip"));
+    assert(!acceptsEncoding("gzip;q=0.000, br", "gzip"));
+    assert(!acceptsEncoding("br, gzip ; q=0", "gzip"));
+
+    // "*" couvre les codages non listés, mais pas ceux refusés explicitement
+    assert(acceptsEncoding("*", "gzip"));
+    assert(acceptsEncoding("br;q=0.5, *;q=0.1", "gzip"));
+    assert(!acceptsEncoding("*;q=0", "gzip"));
+    assert(!acceptsEncoding("gzip;q=0, *", "gzip"));
+    assert(acceptsEncoding("*;q=0, gzip", "gzip"));
+    LOG_SUCCESS("Test Accept-Encoding réussi!");
+}
+
+int main() {
+    LOG_INFO("=== Tests des utilitaires HTTP (Range, Accept-Encoding) ===\n");
+    test_range_forms();
+    test_range_merge();
+    test_range_unsatisfiable();
+    test_range_ignored();
+    test_range_limit();
+    test_accepts_encoding();
+    LOG_SUCCESS("\nTous les tests des utilitaires HTTP ont réussi!");
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include "event/TimerWheel.hpp"
+#include "utils/Common.hpp"
+#include <algorithm>
+#include <cassert>
+#include <unistd.h>
+#include <vector>
+
+// Fait tourner la roue pendant duration_ms et collecte les fds expirés
+static std::vector<int> runFor(TimerWheel& wheel, unsigned long duration_ms) {
+    std::vector<int> all;
+    std::vector<int> expired;
+    unsigned long end = TimerWheel::nowMs() + duration_ms;
+
+    for (unsigned long now = TimerWheel::nowMs(); now < end; now = TimerWheel::nowMs()) {
+        int timeout = wheel.nextTimeout();
+        if (timeout < 0 || static_cast<unsigned long>(timeout) > end - now) {
+            timeout = static_cast<int>(end - now);
+        }
+        usleep(timeout * 1000);
+        wheel.advance(expired);
+        all.insert(all.end(), expired.begin(), expired.end());
+    }
+    return all;
+}
+
+static bool contains(const std::vector<int>& fds, int fd) {
+    return std::find(fds.begin(), fds.end(), fd) != fds.end();
+}
+
+// Expiration simple, annulation et réarmement
+void test_expire_and_cancel() {
+    LOG_INFO("Test expiration et annulation...");
+    TimerWheel wheel(1);
+    assert(wheel.nextTimeout() == -1);
+
+    wheel.schedule(3, 10);
+    wheel.schedule(4, 10);
+    wheel.schedule(5, 200);
+    wheel.cancel(4);
+    assert(wheel.size() == 2);
+    assert(!wheel.isScheduled(4));
+
+    std::vector<int> expired = runFor(wheel, 50);
+    assert(contains(expired, 3));
+    assert(!contains(expired, 4));
+    assert(!contains(expired, 5));
+    assert(wheel.size() == 1);
+
+    // Réarmer repousse l'échéance
+    wheel.schedule(5, 100);
+    expired = runFor(wheel, 150);
+    assert(contains(expired, 5));
+    assert(wheel.size() == 0);
+    assert(wheel.nextTimeout() == -1);
+    LOG_SUCCESS("Test expiration et annulation réussi!");
+}
+
+// Un timer au-delà de la racine doit redescendre par cascade et expirer à l'heure
+void test_cascade() {
+    LOG_INFO("Test cascade entre niveaux...");
+    TimerWheel wheel(1);
+
+    unsigned long start = TimerWheel::nowMs();
+    wheel.schedule(7, 400); // > 256 ticks : niveau 1
+    std::vector<int> expired = runFor(wheel, 300);
+    assert(!contains(expired, 7));
+
+    expired = runFor(wheel, 200);
+    assert(contains(expired, 7));
+    assert(TimerWheel::nowMs() - start >= 400);
+    LOG_SUCCESS("Test cascade réussi!");
+}
+
+int main() {
+    LOG_INFO("=== Tests de la roue de timers ===\n");
+    test_expire_and_cancel();
+    test_cascade();
+    LOG_SUCCESS("\nTous les tests de la roue de timers ont réussi!");
+    return 0;
+}